@@ -101,6 +101,12 @@ def main():
         help="Use Grappler optimizer instead of the optimization passes\n",
         action="store_true")
 
+    parser.add_argument(
+        '--max_vlog_level',
+        type=int,
+        help="Compile out the NGRAPH_TF_VLOG_LEVEL logging above this level\n",
+        action="store")
+
     parser.add_argument(
         '--artifacts_dir',
         type=str,
@@ -391,6 +397,9 @@ def main():
         "-DNGRAPH_TF_USE_GRAPPLER_OPTIMIZER=" +
         flag_string_map[arguments.use_grappler_optimizer]
     ])
+    if arguments.max_vlog_level is not None:
+        ngraph_tf_cmake_flags.extend(
+            ["-DNGRAPH_TF_MAX_VLOG_LEVEL=" + str(arguments.max_vlog_level)])
 
     # Now build the bridge
     ng_tf_whl = build_ngraph_tf(build_dir, artifacts_location,
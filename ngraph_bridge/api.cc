@@ -14,8 +14,17 @@
  * limitations under the License.
  *******************************************************************************/
 
+#include "tensorflow/core/framework/graph.pb.h"
+
 #include "api.h"
 #include "backend_manager.h"
+#include "executable_cache.h"
+#include "log.h"
+#include "memory_tracker.h"
+#include "metrics.h"
+#include "perf_counters.h"
+#include "tracer.h"
+#include "warmup.h"
 
 namespace tensorflow {
 namespace ngraph_bridge {
@@ -58,6 +67,9 @@ void start_logging_placement() { StartLoggingPlacement(); }
 void stop_logging_placement() { StopLoggingPlacement(); }
 bool is_logging_placement() { return IsLoggingPlacement(); }
 
+void set_vlog_level(int level) { SetVLogLevel(level); }
+int get_vlog_level() { return GetVLogLevel(); }
+
 extern void set_disabled_ops(const char* op_type_list) {
   SetDisabledOps(std::string(op_type_list));
 }
@@ -65,6 +77,88 @@ extern void set_disabled_ops(const char* op_type_list) {
 extern const char* get_disabled_ops() {
   return ngraph::join(GetDisabledOps(), ",").c_str();
 }
+
+void enable_perf_counters() { EnablePerfCounters(); }
+void disable_perf_counters() { DisablePerfCounters(); }
+bool is_perf_counters_enabled() { return IsPerfCountersEnabled(); }
+
+bool get_perf_counters(char** report) {
+  *report = strdup(GetPerfCounters().c_str());
+  return true;
+}
+
+bool dump_perf_counters(const char* path) {
+  return DumpPerfCounters(string(path));
+}
+
+void reset_perf_counters() { ResetPerfCounters(); }
+
+void enable_tracing() { EnableTracing(); }
+void disable_tracing() { DisableTracing(); }
+bool is_tracing_enabled() { return IsTracingEnabled(); }
+
+bool get_trace(char** trace) {
+  *trace = strdup(GetTrace().c_str());
+  return true;
+}
+
+bool dump_trace(const char* path) { return DumpTrace(string(path)); }
+
+bool get_metrics(char** metrics) {
+  *metrics = strdup(GetMetrics().c_str());
+  return true;
+}
+
+bool dump_metrics(const char* path) { return DumpMetrics(string(path)); }
+
+void get_executable_cache_stats(uint64_t* hits, uint64_t* misses,
+                                uint64_t* evictions, uint64_t* entries,
+                                uint64_t* bytes) {
+  auto stats = GetExecutableCacheStats();
+  *hits = stats["hits"];
+  *misses = stats["misses"];
+  *evictions = stats["evictions"];
+  *entries = stats["entries"];
+  *bytes = stats["bytes"];
+}
+
+void clear_executable_cache() { ClearExecutableCache(); }
+
+void get_memory_usage(int cluster_id, int64_t* blobs, int64_t* hoisted_params,
+                      int64_t* executables, int64_t* rss) {
+  auto usage = GetMemoryUsage(cluster_id);
+  *blobs = usage["blobs"];
+  *hoisted_params = usage["hoisted_params"];
+  *executables = usage["executables"];
+  *rss = usage["rss"];
+}
+
+// feed_shapes is formatted as "name:d0,d1,...;name:...", with no dimensions
+// for scalars
+bool warmup(const char* graph_def, size_t graph_def_len,
+            const char* feed_shapes, char** report) {
+  map<string, vector<int64_t>> shapes;
+  for (const auto& feed : ngraph::split(feed_shapes, ';')) {
+    if (feed.empty()) {
+      continue;
+    }
+    auto separator = feed.rfind(':');
+    if (separator == string::npos) {
+      *report = strdup(("Invalid feed shape: " + feed).c_str());
+      return false;
+    }
+    auto& shape = shapes[feed.substr(0, separator)];
+    for (const auto& dim : ngraph::split(feed.substr(separator + 1), ',')) {
+      if (!dim.empty()) {
+        shape.push_back(atoll(dim.c_str()));
+      }
+    }
+  }
+  string result;
+  bool ok = Warmup(string(graph_def, graph_def_len), shapes, result);
+  *report = strdup(result.c_str());
+  return ok;
+}
 }
 
 // note that TensorFlow always uses camel case for the C++ API, but not for
@@ -96,10 +190,15 @@ string GetBackend() {
 void StartLoggingPlacement() { _is_logging_placement = true; }
 void StopLoggingPlacement() { _is_logging_placement = false; }
 bool IsLoggingPlacement() {
-  return _is_enabled && (_is_logging_placement ||
-                         std::getenv("NGRAPH_TF_LOG_PLACEMENT") != nullptr);
+  // Checked for every translated node, so the environment is read once
+  static const bool env_logging_placement =
+      std::getenv("NGRAPH_TF_LOG_PLACEMENT") != nullptr;
+  return _is_enabled && (_is_logging_placement || env_logging_placement);
 }
 
+void SetVLogLevel(int level) { LogMessage::SetMinNGraphVLogLevel(level); }
+int GetVLogLevel() { return LogMessage::MinNGraphVLogLevel(); }
+
 std::set<string> GetDisabledOps() {
   if (std::getenv("NGRAPH_TF_DISABLED_OPS") != nullptr) {
     string disabled_ops_str = std::getenv("NGRAPH_TF_DISABLED_OPS");
@@ -124,6 +223,73 @@ void SetDisabledOps(set<string> disabled_ops_set) {
   disabled_op_types = disabled_ops_set;
 }
 
+void EnablePerfCounters() { PerfCounters::Enable(); }
+void DisablePerfCounters() { PerfCounters::Disable(); }
+bool IsPerfCountersEnabled() { return PerfCounters::IsEnabled(); }
+string GetPerfCounters() { return PerfCounters::Report(); }
+bool DumpPerfCounters(const string& path) { return PerfCounters::Dump(path); }
+void ResetPerfCounters() { PerfCounters::Reset(); }
+
+void EnableTracing() { Tracer::Enable(); }
+void DisableTracing() { Tracer::Disable(); }
+bool IsTracingEnabled() { return Tracer::IsEnabled(); }
+string GetTrace() { return Tracer::Flush(); }
+bool DumpTrace(const string& path) { return Tracer::Dump(path); }
+
+string GetMetrics() { return Metrics::Export(); }
+bool DumpMetrics(const string& path) { return Metrics::Dump(path); }
+
+map<string, uint64_t> GetExecutableCacheStats() {
+  auto stats = ExecutableCache::GetStats();
+  return {{"hits", stats.hits},
+          {"misses", stats.misses},
+          {"evictions", stats.evictions},
+          {"entries", stats.entries},
+          {"bytes", stats.bytes}};
+}
+
+void ClearExecutableCache() { ExecutableCache::Clear(); }
+
+map<string, int64_t> GetMemoryUsage(int cluster_id) {
+  return {
+      {"blobs", MemoryTracker::Get(MemoryTracker::kBlobs, cluster_id)},
+      {"hoisted_params",
+       MemoryTracker::Get(MemoryTracker::kHoistedParams, cluster_id)},
+      {"executables",
+       MemoryTracker::Get(MemoryTracker::kExecutables, cluster_id)},
+      {"rss", MemoryTracker::GetSampledRSS()}};
+}
+
+bool Warmup(const string& graph_def,
+            const map<string, vector<int64_t>>& feed_shapes, string& report) {
+  GraphDef parsed_graph_def;
+  if (!parsed_graph_def.ParseFromString(graph_def)) {
+    report = "Unable to parse the GraphDef";
+    return false;
+  }
+  map<string, TensorShape> shapes;
+  for (const auto& feed : feed_shapes) {
+    TensorShape shape;
+    for (auto dim : feed.second) {
+      if (dim < 0) {
+        report = "Shape of " + feed.first + " is not fully defined";
+        return false;
+      }
+      shape.AddDim(dim);
+    }
+    shapes[feed.first] = shape;
+  }
+
+  vector<WarmupReport> reports;
+  auto status = WarmupGraph(parsed_graph_def, shapes, reports);
+  if (!status.ok()) {
+    report = status.error_message();
+    return false;
+  }
+  report = FormatWarmupReports(reports);
+  return true;
+}
+
 }  // namespace api
 }  // namespace ngraph_bridge
 }  // namespace tensorflow
@@ -16,6 +16,7 @@
 
 #pragma once
 
+#include <map>
 #include <set>
 #include <string>
 #include <vector>
@@ -41,8 +42,39 @@ extern void start_logging_placement();
 extern void stop_logging_placement();
 extern bool is_logging_placement();
 
+extern void set_vlog_level(int level);
+extern int get_vlog_level();
+
 extern void set_disabled_ops(const char* op_type_list);
 extern const char* get_disabled_ops();
+
+extern void enable_perf_counters();
+extern void disable_perf_counters();
+extern bool is_perf_counters_enabled();
+extern bool get_perf_counters(char** report);
+extern bool dump_perf_counters(const char* path);
+extern void reset_perf_counters();
+
+extern void enable_tracing();
+extern void disable_tracing();
+extern bool is_tracing_enabled();
+extern bool get_trace(char** trace);
+extern bool dump_trace(const char* path);
+
+extern bool get_metrics(char** metrics);
+extern bool dump_metrics(const char* path);
+
+extern void get_executable_cache_stats(uint64_t* hits, uint64_t* misses,
+                                       uint64_t* evictions, uint64_t* entries,
+                                       uint64_t* bytes);
+extern void clear_executable_cache();
+
+extern void get_memory_usage(int cluster_id, int64_t* blobs,
+                             int64_t* hoisted_params, int64_t* executables,
+                             int64_t* rss);
+
+extern bool warmup(const char* graph_def, size_t graph_def_len,
+                   const char* feed_shapes, char** report);
 }
 
 extern void Enable();
@@ -58,11 +90,55 @@ extern void StartLoggingPlacement();
 extern void StopLoggingPlacement();
 extern bool IsLoggingPlacement();
 
+// Overrides the level set by NGRAPH_TF_VLOG_LEVEL. Levels compiled out with
+// NGRAPH_TF_MAX_VLOG_LEVEL are not logged regardless.
+extern void SetVLogLevel(int level);
+extern int GetVLogLevel();
+
 extern std::set<string> GetDisabledOps();
 
 extern void SetDisabledOps(std::set<string>);
 extern void SetDisabledOps(string);
 
+// IE performance counters, aggregated per TF node. Only clusters compiled
+// while collection is enabled report counters.
+extern void EnablePerfCounters();
+extern void DisablePerfCounters();
+extern bool IsPerfCountersEnabled();
+extern string GetPerfCounters();
+extern bool DumpPerfCounters(const string& path);
+extern void ResetPerfCounters();
+
+// Tracing of the execution phases of clusters. GetTrace and DumpTrace flush
+// the spans recorded so far as Chrome trace JSON.
+extern void EnableTracing();
+extern void DisableTracing();
+extern bool IsTracingEnabled();
+extern string GetTrace();
+extern bool DumpTrace(const string& path);
+
+// Runtime metrics of the clusters (cache hits, misses and evictions, compile
+// and execute time histograms, ...) in the Prometheus text format
+extern string GetMetrics();
+extern bool DumpMetrics(const string& path);
+
+// Counters of the process-wide executable cache: "hits", "misses",
+// "evictions", "entries" and "bytes"
+extern map<string, uint64_t> GetExecutableCacheStats();
+extern void ClearExecutableCache();
+
+// Bytes of memory owned by the bridge: "blobs", "hoisted_params" and
+// "executables", for cluster_id or the whole process if it is negative, and
+// the "rss" of the process as last sampled in the background
+extern map<string, int64_t> GetMemoryUsage(int cluster_id = -1);
+
+// Compiles the clusters of a serialized GraphDef ahead of time, for the given
+// shapes of its placeholders. On success, report holds the outcome and
+// compile time of every cluster as CSV; otherwise it holds the error.
+extern bool Warmup(const string& graph_def,
+                   const map<string, vector<int64_t>>& feed_shapes,
+                   string& report);
+
 }  // namespace api
 }  // namespace ngraph_bridge
 }  // namespace tensorflow
@@ -14,10 +14,10 @@
 // limitations under the License.
 //*****************************************************************************
 
-#include <ie_core.hpp>
 #include "ngraph/ngraph.hpp"
 
 #include "backend.h"
+#include "backend_manager.h"
 #include "default_opset.h"
 #include "log.h"
 
@@ -29,8 +29,7 @@ namespace ngraph_bridge {
 
 Backend::Backend(const string& config) {
   string device = config.substr(0, config.find(":"));
-  InferenceEngine::Core core;
-  auto devices = core.GetAvailableDevices();
+  auto devices = BackendManager::GetSupportedBackends();
   // TODO: Handle multiple devices
   if (find(devices.begin(), devices.end(), device) == devices.end()) {
     stringstream ss;
@@ -40,9 +39,12 @@ Backend::Backend(const string& config) {
   m_device = config;
 }
 
-shared_ptr<Executable> Backend::Compile(shared_ptr<ngraph::Function> func,
-                                        bool) {
-  return make_shared<Executable>(func, m_device);
+shared_ptr<Executable> Backend::Compile(
+    shared_ptr<ngraph::Function> func, bool enable_performance_data,
+    const map<string, string>& config,
+    const vector<ngraph::Shape>& input_shapes) {
+  return make_shared<Executable>(func, m_device, enable_performance_data,
+                                 config, input_shapes);
 }
 
 static std::map<std::string, std::set<shared_ptr<ngraph::Node>>>
@@ -16,6 +16,7 @@
 
 #pragma once
 
+#include <map>
 #include <memory>
 #include <string>
 
@@ -33,8 +34,13 @@ class Backend {
   Backend(const string& configuration_string);
   ~Backend() {}
 
-  shared_ptr<Executable> Compile(shared_ptr<ngraph::Function> func,
-                                 bool enable_performance_data = false);
+  // config holds IE plugin configuration for this function, keys that the
+  // device does not support are ignored. input_shapes specializes a function
+  // with inputs of dynamic shape.
+  shared_ptr<Executable> Compile(
+      shared_ptr<ngraph::Function> func, bool enable_performance_data = false,
+      const map<string, string>& config = {},
+      const vector<ngraph::Shape>& input_shapes = {});
 
   bool IsSupported(const char*) const;
   string& Name() { return m_device; }
@@ -14,8 +14,6 @@
  * limitations under the License.
  *******************************************************************************/
 
-#include <ie_core.hpp>
-
 #include "backend_manager.h"
 #include "log.h"
 
@@ -26,6 +24,8 @@ namespace ngraph_bridge {
 
 shared_ptr<Backend> BackendManager::m_backend;
 mutex BackendManager::m_backend_mutex;
+unique_ptr<InferenceEngine::Core> BackendManager::m_core;
+mutex BackendManager::m_core_mutex;
 
 BackendManager::~BackendManager() {
   NGRAPH_VLOG(2) << "BackendManager::~BackendManager()";
@@ -80,10 +80,22 @@ void BackendManager::CreateBackend(shared_ptr<Backend>& backend,
   NGRAPH_VLOG(2) << "BackendManager::CreateBackend(): " << backend_name;
 }
 
+// Creates the IE core shared by all users lazily, under m_core_mutex. The
+// mutex only guards the creation: backends and executables then call
+// ReadNetwork, LoadNetwork, ImportNetwork etc. on the core concurrently,
+// relying on InferenceEngine::Core being thread-safe itself.
+InferenceEngine::Core& BackendManager::GetCore() {
+  lock_guard<mutex> lock(m_core_mutex);
+  if (m_core == nullptr) {
+    NGRAPH_VLOG(2) << "BackendManager::GetCore(): creating IE core";
+    m_core.reset(new InferenceEngine::Core());
+  }
+  return *m_core;
+}
+
 // Returns the supported backend names
 vector<string> BackendManager::GetSupportedBackends() {
-  InferenceEngine::Core core;
-  return core.GetAvailableDevices();
+  return GetCore().GetAvailableDevices();
 }
 
 }  // namespace ngraph_bridge
@@ -23,6 +23,8 @@
 #include <string>
 #include <vector>
 
+#include <ie_core.hpp>
+
 #include "backend.h"
 
 using namespace std;
@@ -41,6 +43,11 @@ class BackendManager {
   // Returns the currently set backend
   static shared_ptr<Backend> GetBackend();
 
+  // Returns the Inference Engine core shared by all backends and executables
+  // in the process. It is created on first use. Callers don't synchronize
+  // their use of the core, which relies on IE's own thread-safety.
+  static InferenceEngine::Core& GetCore();
+
   ~BackendManager();
 
  private:
@@ -49,6 +56,9 @@ class BackendManager {
 
   static shared_ptr<Backend> m_backend;
   static mutex m_backend_mutex;
+
+  static unique_ptr<InferenceEngine::Core> m_core;
+  static mutex m_core_mutex;
 };
 
 }  // namespace ngraph_bridge
@@ -0,0 +1,100 @@
+/*******************************************************************************
+ * Copyright 2017-2020 Intel Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *******************************************************************************/
+
+#include "tensorflow/core/lib/core/errors.h"
+
+#include "call_bindings.h"
+#include "ie_tensor.h"
+
+using namespace std;
+
+namespace tensorflow {
+namespace ngraph_bridge {
+
+Status CallBindings::Bind(shared_ptr<ngraph::runtime::Tensor>& tensor,
+                          const ngraph::element::Type& type,
+                          const TensorShape& shape, void* data) {
+  // Tensors without data, such as zero-element ones, own their blob and
+  // can't be rebound. Those are reused as they are, since nothing is read
+  // from or written to them.
+  if (tensor != nullptr && tensor->get_element_type() == type) {
+    const auto& bound_shape = tensor->get_shape();
+    bool same_shape = bound_shape.size() == shape.dims();
+    for (int d = 0; same_shape && d < shape.dims(); d++) {
+      same_shape = bound_shape[d] == shape.dim_size(d);
+    }
+    auto ie_tensor = static_pointer_cast<IETensor>(tensor);
+    if (same_shape && ie_tensor->IsRebindable() == (data != nullptr)) {
+      if (data != nullptr) {
+        ie_tensor->Rebind(data);
+      }
+      return Status::OK();
+    }
+  }
+
+  ngraph::Shape ng_shape(shape.dims());
+  for (int d = 0; d < shape.dims(); d++) {
+    ng_shape[d] = shape.dim_size(d);
+  }
+  try {
+    tensor = make_shared<IETensor>(type, ng_shape, data);
+  } catch (const std::exception& exp) {
+    tensor = nullptr;
+    return errors::Internal("Failed to create tensor of type ",
+                            type.get_type_name(), " and shape ",
+                            shape.DebugString(), ": ", exp.what());
+  }
+  return Status::OK();
+}
+
+CallBindingsPool::CallBindingsPool(size_t capacity) : m_capacity(capacity) {
+  m_idle.reserve(capacity);
+}
+
+unique_ptr<CallBindings> CallBindingsPool::Acquire(
+    const shared_ptr<Executable>& exec, size_t num_inputs,
+    size_t num_outputs) {
+  {
+    lock_guard<mutex> lock(m_mutex);
+    for (auto it = m_idle.begin(); it != m_idle.end(); ++it) {
+      if ((*it)->exec.lock() == exec) {
+        auto bindings = move(*it);
+        *it = move(m_idle.back());
+        m_idle.pop_back();
+        return bindings;
+      }
+    }
+  }
+
+  unique_ptr<CallBindings> bindings(new CallBindings());
+  bindings->exec = exec;
+  bindings->inputs.resize(num_inputs);
+  bindings->outputs.resize(num_outputs);
+  return bindings;
+}
+
+void CallBindingsPool::Release(unique_ptr<CallBindings> bindings) {
+  lock_guard<mutex> lock(m_mutex);
+  if (m_idle.size() < m_capacity) {
+    m_idle.push_back(move(bindings));
+  } else {
+    // The pool is full, replace the bindings of another call
+    m_idle.front() = move(bindings);
+  }
+}
+
+}  // namespace ngraph_bridge
+}  // namespace tensorflow
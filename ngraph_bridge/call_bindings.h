@@ -0,0 +1,84 @@
+/*******************************************************************************
+ * Copyright 2017-2020 Intel Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *******************************************************************************/
+
+#pragma once
+
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "tensorflow/core/framework/tensor.h"
+#include "tensorflow/core/lib/core/status.h"
+#include "tensorflow/core/framework/tensor_shape.h"
+
+#include "ngraph/ngraph.hpp"
+#include "ngraph_bridge/executable.h"
+
+namespace tensorflow {
+namespace ngraph_bridge {
+
+// The IE tensors wrapping the inputs and outputs of a call to an executable.
+// Between calls they are kept in a CallBindingsPool, and the next call with
+// the same shapes only points them at its memory.
+struct CallBindings {
+  std::weak_ptr<Executable> exec;
+  std::vector<std::shared_ptr<ngraph::runtime::Tensor>> inputs;
+  std::vector<std::shared_ptr<ngraph::runtime::Tensor>> outputs;
+  // Temporaries owning the memory inputs are bound to, such as padded
+  // inputs, kept alive until the call completes
+  std::vector<Tensor> held_inputs;
+
+  // Points input or output i at data, creating its tensor if there is none
+  // of the given type and shape yet. data may be null for tensors without
+  // elements.
+  Status BindInput(int i, const ngraph::element::Type& type,
+                   const TensorShape& shape, void* data) {
+    return Bind(inputs[i], type, shape, data);
+  }
+  Status BindOutput(int i, const ngraph::element::Type& type,
+                    const TensorShape& shape, void* data) {
+    return Bind(outputs[i], type, shape, data);
+  }
+
+ private:
+  static Status Bind(std::shared_ptr<ngraph::runtime::Tensor>& tensor,
+                     const ngraph::element::Type& type,
+                     const TensorShape& shape, void* data);
+};
+
+// Keeps the bindings of completed calls for reuse. Bindings are only reused
+// for the executable they were last used with.
+class CallBindingsPool {
+ public:
+  explicit CallBindingsPool(size_t capacity);
+
+  // Returns idle bindings of exec, or new ones with the given number of
+  // inputs and outputs, all unbound
+  std::unique_ptr<CallBindings> Acquire(
+      const std::shared_ptr<Executable>& exec, size_t num_inputs,
+      size_t num_outputs);
+  // Keeps bindings for reuse, unless the pool is full. Calls using them must
+  // have completed.
+  void Release(std::unique_ptr<CallBindings> bindings);
+
+ private:
+  size_t m_capacity;
+  std::mutex m_mutex;
+  std::vector<std::unique_ptr<CallBindings>> m_idle;
+};
+
+}  // namespace ngraph_bridge
+}  // namespace tensorflow
@@ -14,14 +14,22 @@
 // limitations under the License.
 //*****************************************************************************
 
+#include <algorithm>
+#include <cctype>
+
 #include "ngraph/ngraph.hpp"
 
 #include <ie_plugin_config.hpp>
 
+#include "backend_manager.h"
 #include "default_opset.h"
 #include "executable.h"
 #include "ie_tensor.h"
 #include "log.h"
+#include "network_cache.h"
+#include "perf_counters.h"
+#include "shared_weights.h"
+#include "tracer.h"
 #include "utils.h"
 
 using namespace std;
@@ -30,8 +38,28 @@ using namespace ngraph;
 namespace tensorflow {
 namespace ngraph_bridge {
 
-Executable::Executable(shared_ptr<Function> func, string device)
-    : m_device{device}, m_trivial_fn{nullptr}, m_function(func) {
+static string GetOutputName(const shared_ptr<ngraph::Node>& node) {
+  // Since IE has no "result" nodes, we set the blob corresponding to the
+  // parent of this result node
+  auto parent = node->input_value(0).get_node_shared_ptr();
+  auto name = parent->get_friendly_name();
+  // if parent has multiple outputs, correctly identify the output feeding
+  // into this result
+  if (parent->outputs().size() > 1) {
+    name += "." + to_string(node->input_value(0).get_index());
+  }
+  return name;
+}
+
+Executable::Executable(shared_ptr<Function> func, string device,
+                       bool enable_perf_counters,
+                       const map<string, string>& config,
+                       const vector<Shape>& input_shapes)
+    : m_max_infer_reqs{1},
+      m_device{device},
+      m_perf_counters_enabled{enable_perf_counters},
+      m_trivial_fn{nullptr},
+      m_function(func) {
   NGRAPH_VLOG(2) << "Checking for unsupported ops";
   const auto& opset = ngraph::get_opset5();
   for (const auto& node : func->get_ops()) {
@@ -43,6 +71,12 @@ Executable::Executable(shared_ptr<Function> func, string device)
     }
   }
 
+  // The function will be reshaped, which must not affect other executables
+  // specialized from it
+  if (!input_shapes.empty()) {
+    func = ngraph::clone_function(*func);
+  }
+
   NGRAPH_VLOG(2) << "Checking for unused parameters";
   auto parameters = func->get_parameters();
   ngraph::ParameterVector used_parameters;
@@ -79,6 +113,22 @@ Executable::Executable(shared_ptr<Function> func, string device)
   if (trivial_fn) {
     NGRAPH_VLOG(2) << "Function is trivial and can be short-circuited";
     m_trivial_fn = func;
+    for (auto result : func->get_results()) {
+      auto parent = result->input_value(0).get_node_shared_ptr();
+      auto param = ngraph::as_type_ptr<opset::Parameter>(parent);
+      if (param == nullptr) {
+        m_trivial_inputs.push_back(-1);
+        continue;
+      }
+      // Inputs are indexed by the parameters of the original function, which
+      // includes the unused ones
+      auto index = find(parameters.begin(), parameters.end(), param);
+      if (index == parameters.end()) {
+        throw runtime_error("Input parameter " + param->get_friendly_name() +
+                            " not found in trivial function");
+      }
+      m_trivial_inputs.push_back(index - parameters.begin());
+    }
     return;
   }
 
@@ -122,14 +172,186 @@ Executable::Executable(shared_ptr<Function> func, string device)
     }
   }
 
-  m_function = func;
+  // Constants shared with other executables are hoisted on a clone, so that
+  // the network can still be loaded with the constants embedded
+  auto shared_func = func;
+  if (SharedWeights::IsEnabled()) {
+    shared_func = ShareWeights(func);
+  }
+  try {
+    LoadNetwork(shared_func, parameters, input_shapes, config);
+  } catch (const std::exception& ex) {
+    if (m_shared_weights.empty()) {
+      throw;
+    }
+    NGRAPH_VLOG(1) << "Unable to load " << func->get_friendly_name()
+                   << " with shared weights, embedding them: " << ex.what();
+    m_shared_weights.clear();
+    m_input_bindings.clear();
+    m_output_names.clear();
+    m_layer_tf_nodes.clear();
+    LoadNetwork(func, parameters, input_shapes, config);
+  }
+
+  // The size of the infer request pool can be set explicitly, otherwise we
+  // go with what the plugin considers optimal for this network
+  const char* pool_size_env = std::getenv("NGRAPH_TF_INFER_REQUEST_POOL_SIZE");
+  if (pool_size_env != nullptr) {
+    m_max_infer_reqs = atoi(pool_size_env);
+  } else {
+    try {
+      m_max_infer_reqs =
+          m_exe_network
+              .GetMetric(METRIC_KEY(OPTIMAL_NUMBER_OF_INFER_REQUESTS))
+              .as<unsigned int>();
+    } catch (const std::exception& e) {
+      NGRAPH_VLOG(1) << "Unable to query optimal number of infer requests: "
+                     << e.what();
+    }
+  }
+  if (m_max_infer_reqs < 1) {
+    m_max_infer_reqs = 1;
+  }
+  NGRAPH_VLOG(2) << "Infer request pool size for " << m_device << ": "
+                 << m_max_infer_reqs;
+}
+
+shared_ptr<Function> Executable::ShareWeights(shared_ptr<Function> func) {
+  // FIXME: IE cannot handle input parameters with i64/u64 precision
+  vector<shared_ptr<opset::Constant>> constants;
+  for (const auto& node : func->get_ops()) {
+    auto constant = ngraph::as_type_ptr<opset::Constant>(node);
+    if (constant != nullptr && SharedWeights::IsShareable(*constant) &&
+        constant->get_element_type() != ngraph::element::i64 &&
+        constant->get_element_type() != ngraph::element::u64) {
+      constants.push_back(constant);
+    }
+  }
+  if (constants.empty()) {
+    return func;
+  }
+
+  // The clone shares the data of the constants
+  NodeMap node_map;
+  auto shared_func = ngraph::clone_function(*func, node_map);
+  auto parameters = shared_func->get_parameters();
+  for (const auto& constant : constants) {
+    auto clone = node_map.at(constant.get());
+    auto param = make_shared<opset::Parameter>(constant->get_element_type(),
+                                               constant->get_shape());
+    param->set_friendly_name(clone->get_friendly_name());
+    ngraph::replace_node(clone, param);
+    parameters.push_back(param);
+    m_shared_weights.push_back(
+        make_pair(param->get_friendly_name(), SharedWeights::Get(constant)));
+  }
+  NGRAPH_VLOG(1) << "Hoisted " << constants.size() << " shared weights of "
+                 << func->get_friendly_name();
+  return make_shared<Function>(shared_func->get_results(), parameters,
+                               shared_func->get_friendly_name());
+}
+
+void Executable::LoadNetwork(shared_ptr<Function> func,
+                             const ParameterVector& parameters,
+                             const vector<Shape>& input_shapes,
+                             const map<string, string>& config) {
+  m_ie_function = func;
 
   NGRAPH_VLOG(2) << "Creating IE CNN network using nGraph function";
   m_network = InferenceEngine::CNNNetwork(func);
 
-  InferenceEngine::Core ie;
+  // A function with dynamic input shapes is specialized to the shapes it is
+  // going to be called with, which only reruns IE shape inference
+  if (!input_shapes.empty()) {
+    InferenceEngine::ICNNNetwork::InputShapes ie_shapes;
+    for (int i = 0; i < parameters.size(); i++) {
+      if (parameters[i]->get_partial_shape().is_static() ||
+          find(m_skipped_inputs.begin(), m_skipped_inputs.end(), i) !=
+              m_skipped_inputs.end()) {
+        continue;
+      }
+      auto& shape = input_shapes[i];
+      ie_shapes[parameters[i]->get_friendly_name()] =
+          InferenceEngine::SizeVector(shape.begin(), shape.end());
+    }
+    NGRAPH_VLOG(2) << "Reshaping IE CNN network";
+    m_network.reshape(ie_shapes);
+  }
+
+  // Resolve which IE inputs and outputs the tensors passed to Call are bound
+  // to once, so that calls only have to set blobs
+  NGRAPH_VLOG(2) << "Building input and output bindings";
+  auto input_info = m_network.getInputsInfo();
+  auto bound_parameters = func->get_parameters();
+  size_t num_bound = bound_parameters.size() - m_hoisted_params.size() -
+                     m_shared_weights.size();
+  size_t skipped = 0;
+  for (int i = 0, j = 0; j < num_bound; i++) {
+    if (skipped < m_skipped_inputs.size() && m_skipped_inputs[skipped] == i) {
+      skipped++;
+      continue;
+    }
+    auto input_name = bound_parameters[j++]->get_friendly_name();
+    if (input_info.find(input_name) == input_info.end()) {
+      NGRAPH_VLOG(1) << "Skipping unused input " << input_name;
+      continue;
+    }
+    m_input_bindings.push_back(make_pair(i, input_name));
+  }
+  for (auto params : {&m_hoisted_params, &m_shared_weights}) {
+    for (auto it = params->begin(); it != params->end();) {
+      if (input_info.find(it->first) == input_info.end()) {
+        NGRAPH_VLOG(1) << "Skipping unused hoisted param " << it->first;
+        it = params->erase(it);
+      } else {
+        ++it;
+      }
+    }
+  }
+  for (const auto& result : func->get_results()) {
+    m_output_names.push_back(GetOutputName(result));
+  }
+
+  auto& ie = BackendManager::GetCore();
   std::map<string, string> options;
 
+  if (!config.empty()) {
+    vector<string> supported_keys;
+    try {
+      supported_keys =
+          ie.GetMetric(m_device, METRIC_KEY(SUPPORTED_CONFIG_KEYS))
+              .as<vector<string>>();
+    } catch (const std::exception& e) {
+      NGRAPH_VLOG(1) << "Unable to query supported config keys of "
+                     << m_device << ": " << e.what();
+    }
+    for (const auto& it : config) {
+      string key = it.first;
+      transform(key.begin(), key.end(), key.begin(), ::toupper);
+      if (find(supported_keys.begin(), supported_keys.end(), key) ==
+          supported_keys.end()) {
+        NGRAPH_VLOG(2) << "Ignoring config " << it.first << " not supported by "
+                       << m_device;
+        continue;
+      }
+      NGRAPH_VLOG(2) << "Setting config " << key << "=" << it.second;
+      options[key] = it.second;
+    }
+  }
+
+  if (m_perf_counters_enabled) {
+    options[InferenceEngine::PluginConfigParams::KEY_PERF_COUNT] =
+        InferenceEngine::PluginConfigParams::YES;
+    // Layers are named after nGraph nodes, whose provenance tags hold the
+    // name of the TF node they were created for
+    for (const auto& node : func->get_ops()) {
+      auto tags = node->get_provenance_tags();
+      if (!tags.empty()) {
+        m_layer_tf_nodes[node->get_friendly_name()] = *tags.begin();
+      }
+    }
+  }
+
   if (utils::DumpAllGraphs()) {
     auto& name = m_function->get_friendly_name();
     m_network.serialize(name + ".xml", name + ".bin");
@@ -142,10 +364,75 @@ Executable::Executable(shared_ptr<Function> func, string device)
 
   NGRAPH_VLOG(2) << "Loading IE CNN network to device " << m_device;
 
-  // Load network to the plugin (m_device) and create an infer request
-  InferenceEngine::ExecutableNetwork exe_network =
-      ie.LoadNetwork(m_network, m_device, options);
-  m_infer_req = exe_network.CreateInferRequest();
+  // Load network to the plugin (m_device), or import a previously compiled
+  // one from the network cache. Infer requests are created on demand in
+  // AcquireInferRequest.
+  {
+    TraceSpan span("LoadNetwork");
+    uint64 key;
+    if (NetworkCache::IsEnabled() &&
+        NetworkCache::ComputeKey(m_network.getFunction(), m_device, options,
+                                 &key)) {
+      if (!NetworkCache::Import(key, ie, m_device, options, m_exe_network)) {
+        m_exe_network = ie.LoadNetwork(m_network, m_device, options);
+        NetworkCache::Export(key, m_exe_network);
+      }
+    } else {
+      m_exe_network = ie.LoadNetwork(m_network, m_device, options);
+    }
+  }
+}
+
+Executable::PooledInferRequest* Executable::AcquireInferRequest() {
+  unique_lock<mutex> lock(m_infer_req_mutex);
+  m_infer_req_cv.wait(lock, [this] {
+    return !m_idle_infer_reqs.empty() ||
+           m_infer_reqs.size() < m_max_infer_reqs;
+  });
+  return TryAcquireInferRequest();
+}
+
+Executable::PooledInferRequest* Executable::TryAcquireInferRequest() {
+  if (!m_idle_infer_reqs.empty()) {
+    auto infer_req = m_idle_infer_reqs.back();
+    m_idle_infer_reqs.pop_back();
+    return infer_req;
+  }
+  NGRAPH_VLOG(2) << "Creating infer request " << m_infer_reqs.size()
+                 << " for " << m_function->get_friendly_name();
+  auto pooled = unique_ptr<PooledInferRequest>(new PooledInferRequest());
+  auto infer_req = pooled.get();
+  infer_req->req = m_exe_network.CreateInferRequest();
+  infer_req->bound_blobs.resize(m_input_bindings.size() +
+                                m_hoisted_params.size() +
+                                m_shared_weights.size() +
+                                m_output_names.size());
+  // The callback only refers to state owned by this executable, so that the
+  // request does not keep anything else alive between calls
+  using CompletionCallback = function<void(InferenceEngine::InferRequest,
+                                           InferenceEngine::StatusCode)>;
+  infer_req->req.SetCompletionCallback<CompletionCallback>(
+      [this, infer_req](InferenceEngine::InferRequest,
+                        InferenceEngine::StatusCode code) {
+        OnAsyncComplete(infer_req, code);
+      });
+  m_infer_reqs.push_back(move(pooled));
+  return infer_req;
+}
+
+void Executable::ReleaseInferRequest(PooledInferRequest* infer_req) {
+  unique_lock<mutex> lock(m_infer_req_mutex);
+  if (!m_pending_calls.empty()) {
+    auto call = move(m_pending_calls.front());
+    m_pending_calls.pop_front();
+    lock.unlock();
+    StartAsync(infer_req, call.inputs, move(call.outputs), move(call.done),
+               call.trace_context);
+    return;
+  }
+  m_idle_infer_reqs.push_back(infer_req);
+  lock.unlock();
+  m_infer_req_cv.notify_one();
 }
 
 bool Executable::Call(const vector<shared_ptr<runtime::Tensor>>& inputs,
@@ -156,85 +443,204 @@ bool Executable::Call(const vector<shared_ptr<runtime::Tensor>>& inputs,
     return CallTrivial(inputs, outputs);
   }
 
-  // Check if the number of inputs that the CNN network expects is equal to the
-  // sum of the
-  // inputs specified and the inputs we hoisted, if any.
-  InferenceEngine::InputsDataMap input_info = m_network.getInputsInfo();
-  if (input_info.size() > (inputs.size() + m_hoisted_params.size())) {
-    throw runtime_error("Function inputs (" + to_string(input_info.size()) +
-                        ") number greater than number of given inputs (" +
-                        to_string(inputs.size() + m_hoisted_params.size()) +
-                        ")");
+  // Borrow an infer request for the duration of this call, making sure it is
+  // returned to the pool even if inference throws
+  struct InferRequestGuard {
+    Executable* exec;
+    PooledInferRequest* pooled;
+    ~InferRequestGuard() { exec->ReleaseInferRequest(pooled); }
+  } guard{this, AcquireInferRequest()};
+  auto& infer_req = guard.pooled->req;
+
+  {
+    TraceSpan span("SetBlobs");
+    SetInputBlobs(*guard.pooled, inputs);
+    SetOutputBlobs(*guard.pooled, outputs);
+  }
+  {
+    TraceSpan span("Infer");
+    infer_req.Infer();
   }
+  GetOutputBlobs(infer_req, outputs);
+  RecordPerfCounters(infer_req);
+  return true;
+}
 
-  //  Prepare input blobs
-  auto func = m_network.getFunction();
-  auto parameters = func->get_parameters();
-  int j = 0;
-  for (int i = 0; i < inputs.size(); i++) {
-    if (find(m_skipped_inputs.begin(), m_skipped_inputs.end(), i) !=
-        m_skipped_inputs.end()) {
-      continue;
-    }
-    auto input_name = parameters[j++]->get_friendly_name();
-    if (input_info.find(input_name) == input_info.end()) {
-      NGRAPH_VLOG(1) << "Skipping unused input " << input_name;
-      continue;
+void Executable::CallAsync(const vector<shared_ptr<runtime::Tensor>>& inputs,
+                           vector<shared_ptr<runtime::Tensor>> outputs,
+                           CallDone done) {
+  if (m_trivial_fn) {
+    NGRAPH_VLOG(2) << "Calling trivial IE function with inputs="
+                   << inputs.size() << " outputs=" << outputs.size();
+    exception_ptr error;
+    try {
+      CallTrivial(inputs, outputs);
+    } catch (...) {
+      error = current_exception();
     }
-    shared_ptr<IETensor> tv = static_pointer_cast<IETensor>(inputs[i]);
-    m_infer_req.SetBlob(input_name, tv->get_blob());
+    done(error, outputs);
+    return;
   }
 
-  for (const auto& it : m_hoisted_params) {
-    auto input_name = it.first;
-    if (input_info.find(input_name) == input_info.end()) {
-      NGRAPH_VLOG(1) << "Skipping unused hoisted param " << input_name;
-      continue;
+  // Calls are queued rather than waiting for a request, which would block
+  // the TF thread running the op
+  PooledInferRequest* pooled;
+  {
+    lock_guard<mutex> lock(m_infer_req_mutex);
+    pooled = TryAcquireInferRequest();
+    if (pooled == nullptr) {
+      NGRAPH_VLOG(4) << "Queueing call, all " << m_max_infer_reqs
+                     << " infer requests are busy";
+      m_pending_calls.push_back(
+          {inputs, move(outputs), move(done), Tracer::CurrentContext()});
+      return;
     }
-    shared_ptr<IETensor> tv = static_pointer_cast<IETensor>(it.second);
-    m_infer_req.SetBlob(input_name, tv->get_blob());
+  }
+  StartAsync(pooled, inputs, move(outputs), move(done),
+             Tracer::CurrentContext());
+}
+
+void Executable::StartAsync(PooledInferRequest* pooled,
+                            const vector<shared_ptr<runtime::Tensor>>& inputs,
+                            vector<shared_ptr<runtime::Tensor>> outputs,
+                            CallDone done, const TraceContext& trace_context) {
+  try {
+    TraceSpan span("SetBlobs");
+    SetInputBlobs(*pooled, inputs);
+    SetOutputBlobs(*pooled, outputs);
+  } catch (...) {
+    ReleaseInferRequest(pooled);
+    done(current_exception(), outputs);
+    return;
   }
 
-  InferenceEngine::OutputsDataMap output_info = m_network.getOutputsInfo();
-  if (outputs.size() == 0 && output_info.size() > 0) {
-    outputs.resize(output_info.size(), nullptr);
+  // Input tensors own the memory backing the input blobs, so they have to be
+  // kept alive until inference completes
+  pooled->async_inputs = inputs;
+  pooled->async_outputs = move(outputs);
+  pooled->async_done = move(done);
+  pooled->async_start_us = Tracer::IsEnabled() ? Tracer::NowMicros() : -1;
+  pooled->async_trace_context = trace_context;
+  try {
+    pooled->req.StartAsync();
+  } catch (...) {
+    auto async_done = move(pooled->async_done);
+    auto async_outputs = move(pooled->async_outputs);
+    pooled->async_inputs.clear();
+    ReleaseInferRequest(pooled);
+    async_done(current_exception(), async_outputs);
   }
+}
 
-  auto get_output_name = [](std::shared_ptr<ngraph::Node> node) {
-    // Since IE has no "result" nodes, we set the blob corresponding to the
-    // parent of this result node
-    auto parent = node->input_value(0).get_node_shared_ptr();
-    auto name = parent->get_friendly_name();
-    // if parent has multiple outputs, correctly identify the output feeding
-    // into this result
-    if (parent->outputs().size() > 1) {
-      name += "." + to_string(node->input_value(0).get_index());
+void Executable::OnAsyncComplete(PooledInferRequest* pooled,
+                                 InferenceEngine::StatusCode code) {
+  if (pooled->async_start_us >= 0) {
+    Tracer::Record("Infer", pooled->async_start_us, Tracer::NowMicros(),
+                   pooled->async_trace_context);
+  }
+  exception_ptr error;
+  try {
+    if (code != InferenceEngine::StatusCode::OK) {
+      throw runtime_error("Asynchronous inference failed with status " +
+                          to_string(code));
     }
-    return name;
-  };
+    GetOutputBlobs(pooled->req, pooled->async_outputs);
+    RecordPerfCounters(pooled->req);
+  } catch (...) {
+    error = current_exception();
+  }
+
+  // Take the call state out of the request before handing it back to the
+  // pool, since the request may be reused as soon as it is released
+  auto done = move(pooled->async_done);
+  auto outputs = move(pooled->async_outputs);
+  pooled->async_inputs.clear();
+  ReleaseInferRequest(pooled);
+  done(error, outputs);
+}
+
+void Executable::RecordPerfCounters(InferenceEngine::InferRequest& infer_req) {
+  if (m_perf_counters_enabled) {
+    PerfCounters::Record(infer_req.GetPerformanceCounts(), m_layer_tf_nodes);
+  }
+}
+
+void Executable::SetBlob(PooledInferRequest& infer_req, size_t index,
+                         const string& name,
+                         const shared_ptr<runtime::Tensor>& tensor) {
+  auto tv = static_pointer_cast<IETensor>(tensor);
+  auto blob = tv->get_blob();
+  // Blobs over external memory may have been rebound since they were set
+  pair<const InferenceEngine::Blob*, const void*> bound(blob.get(),
+                                                        tv->get_data_ptr());
+  if (infer_req.bound_blobs[index] != bound) {
+    infer_req.req.SetBlob(name, blob);
+    infer_req.bound_blobs[index] = bound;
+  }
+}
+
+size_t Executable::GetHoistedParamBytes() const {
+  size_t bytes = 0;
+  for (const auto& it : m_hoisted_params) {
+    bytes += it.second->get_size_in_bytes();
+  }
+  return bytes;
+}
+
+void Executable::SetInputBlobs(
+    PooledInferRequest& infer_req,
+    const vector<shared_ptr<runtime::Tensor>>& inputs) {
+  // Check that every input the CNN network expects has been given
+  if (!m_input_bindings.empty() &&
+      m_input_bindings.back().first >= inputs.size()) {
+    throw runtime_error("Function inputs (" +
+                        to_string(m_input_bindings.back().first + 1) +
+                        ") number greater than number of given inputs (" +
+                        to_string(inputs.size()) + ")");
+  }
+
+  size_t index = 0;
+  for (const auto& binding : m_input_bindings) {
+    SetBlob(infer_req, index++, binding.second, inputs[binding.first]);
+  }
+  for (const auto& it : m_hoisted_params) {
+    SetBlob(infer_req, index++, it.first, it.second);
+  }
+  for (const auto& it : m_shared_weights) {
+    SetBlob(infer_req, index++, it.first, it.second);
+  }
+}
+
+void Executable::SetOutputBlobs(PooledInferRequest& infer_req,
+                                vector<shared_ptr<runtime::Tensor>>& outputs) {
+  if (outputs.size() == 0 && m_output_names.size() > 0) {
+    outputs.resize(m_output_names.size(), nullptr);
+  }
 
   //  Prepare output blobs
-  auto results = func->get_results();
-  for (int i = 0; i < results.size(); i++) {
+  size_t offset = m_input_bindings.size() + m_hoisted_params.size() +
+                  m_shared_weights.size();
+  for (int i = 0; i < m_output_names.size(); i++) {
     if (outputs[i] != nullptr) {
       NGRAPH_VLOG(4) << "Executable::call() SetBlob()";
-      shared_ptr<IETensor> tv = static_pointer_cast<IETensor>(outputs[i]);
-      m_infer_req.SetBlob(get_output_name(results[i]), tv->get_blob());
+      SetBlob(infer_req, offset + i, m_output_names[i], outputs[i]);
+    } else {
+      // The request provides the output blob itself
+      infer_req.bound_blobs[offset + i] = {nullptr, nullptr};
     }
   }
+}
 
-  m_infer_req.Infer();
-
+void Executable::GetOutputBlobs(InferenceEngine::InferRequest& infer_req,
+                                vector<shared_ptr<runtime::Tensor>>& outputs) {
   // Set dynamic output blobs
-  for (int i = 0; i < results.size(); i++) {
+  for (int i = 0; i < m_output_names.size(); i++) {
     if (outputs[i] == nullptr) {
       NGRAPH_VLOG(4) << "Executable::call() GetBlob()";
-      auto blob = m_infer_req.GetBlob(get_output_name(results[i]));
+      auto blob = infer_req.GetBlob(m_output_names[i]);
       outputs[i] = make_shared<IETensor>(blob);
     }
   }
-
-  return true;
 }
 
 bool Executable::CallTrivial(const vector<shared_ptr<runtime::Tensor>>& inputs,
@@ -246,7 +652,8 @@ bool Executable::CallTrivial(const vector<shared_ptr<runtime::Tensor>>& inputs,
   }
 
   for (int i = 0; i < results.size(); i++) {
-    auto& shape = results[i]->get_shape();
+    auto& pshape = results[i]->get_output_partial_shape(0);
+    auto shape = pshape.is_static() ? pshape.to_shape() : Shape{};
     if (count(shape.begin(), shape.end(), 0)) {
       if (outputs[i] == nullptr) {
         outputs[i] =
@@ -256,23 +663,15 @@ bool Executable::CallTrivial(const vector<shared_ptr<runtime::Tensor>>& inputs,
       continue;
     }
     auto parent = results[i]->input_value(0).get_node_shared_ptr();
-    if (ngraph::is_type<opset::Parameter>(parent)) {
+    if (m_trivial_inputs[i] >= 0) {
       NGRAPH_VLOG(2) << "Calling parameter -> result function...";
-      auto param = ngraph::as_type_ptr<opset::Parameter>(parent);
-      auto index = m_trivial_fn->get_parameter_index(param);
-      if (index < 0) {
-        throw runtime_error("Input parameter " + param->get_friendly_name() +
-                            " not found in trivial function");
-      }
+      auto& input = inputs[m_trivial_inputs[i]];
       if (outputs[i] == nullptr) {
-        outputs[i] = make_shared<IETensor>(inputs[index]->get_element_type(),
-                                           inputs[index]->get_shape());
+        outputs[i] = input;
+      } else {
+        auto tv = static_pointer_cast<IETensor>(input);
+        outputs[i]->write(tv->get_data_ptr(), input->get_size_in_bytes());
       }
-      auto size = inputs[index]->get_size_in_bytes();
-      unsigned char* buf_ptr = new unsigned char[size];
-      inputs[index]->read(buf_ptr, size);
-      outputs[i]->write(buf_ptr, size);
-      delete buf_ptr;
     } else if (ngraph::is_type<opset::Constant>(parent)) {
       NGRAPH_VLOG(2) << "Calling constant -> result function...";
       auto constant = ngraph::as_type_ptr<opset::Constant>(parent);
@@ -16,13 +16,22 @@
 
 #pragma once
 
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <map>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include <ie_core.hpp>
 #include "ngraph/ngraph.hpp"
 
+#include "tracer.h"
+
 using namespace std;
 
 namespace tensorflow {
@@ -32,30 +41,150 @@ namespace ngraph_bridge {
 // function.
 class Executable {
  public:
-  Executable(shared_ptr<ngraph::Function> func, string device);
+  // Invoked when an asynchronous call completes. The exception pointer is null
+  // on success; outputs holds the (possibly newly created) output tensors.
+  using CallDone = function<void(
+      exception_ptr, vector<shared_ptr<ngraph::runtime::Tensor>>&)>;
+
+  // With enable_perf_counters set, IE per-layer performance counters are
+  // collected after each inference and aggregated in PerfCounters. config is
+  // passed on to the plugin when loading the network. If func has inputs of
+  // dynamic shape, input_shapes gives the static shape of every input.
+  Executable(shared_ptr<ngraph::Function> func, string device,
+             bool enable_perf_counters = false,
+             const map<string, string>& config = {},
+             const vector<ngraph::Shape>& input_shapes = {});
   ~Executable() {}
   bool Call(const vector<shared_ptr<ngraph::runtime::Tensor>>& inputs,
             vector<shared_ptr<ngraph::runtime::Tensor>>& outputs);
+  // Starts inference without blocking the calling thread. done is called
+  // exactly once, from an Inference Engine thread unless the call fails
+  // before inference is started. While all infer requests are busy the call
+  // is queued, and started once a request completes. The executable must
+  // not be destroyed from within done.
+  void CallAsync(const vector<shared_ptr<ngraph::runtime::Tensor>>& inputs,
+                 vector<shared_ptr<ngraph::runtime::Tensor>> outputs,
+                 CallDone done);
 
+  // Returns the results of the function the outputs of calls are shaped
+  // after, i.e. of the function the IE network was loaded from if any
   const ngraph::ResultVector& GetResults() {
-    return m_function->get_results();
+    return (m_ie_function ? m_ie_function : m_function)->get_results();
   };
 
+  // Trivial functions are never run through IE, so callers may forward their
+  // inputs and constants to the results directly instead of calling them
+  bool IsTrivial() const { return m_trivial_fn != nullptr; }
+  // For trivial functions, the index of the input that each result forwards,
+  // or -1 if the result is a constant or an empty tensor
+  const vector<int>& GetTrivialInputs() const { return m_trivial_inputs; }
+  // Bytes of the constants hoisted to parameters
+  size_t GetHoistedParamBytes() const;
+
  private:
+  // An infer request owned by the pool, along with the state of the
+  // asynchronous call in flight on it, if any
+  struct PooledInferRequest {
+    InferenceEngine::InferRequest req;
+    // The blobs last set on req and their memory, for the inputs, the
+    // hoisted parameters, the shared weights and the outputs in this order.
+    // Setting the same blob over the same memory again is skipped.
+    vector<pair<const InferenceEngine::Blob*, const void*>> bound_blobs;
+    vector<shared_ptr<ngraph::runtime::Tensor>> async_inputs;
+    vector<shared_ptr<ngraph::runtime::Tensor>> async_outputs;
+    CallDone async_done;
+    // Start of the asynchronous inference if it is traced, -1 otherwise
+    int64_t async_start_us = -1;
+    TraceContext async_trace_context;
+  };
+
+  // An asynchronous call waiting for an infer request
+  struct PendingCall {
+    vector<shared_ptr<ngraph::runtime::Tensor>> inputs;
+    vector<shared_ptr<ngraph::runtime::Tensor>> outputs;
+    CallDone done;
+    TraceContext trace_context;
+  };
+
   bool CallTrivial(const vector<shared_ptr<ngraph::runtime::Tensor>>& inputs,
                    vector<shared_ptr<ngraph::runtime::Tensor>>& outputs);
 
+  // Hoists the constants of func that SharedWeights can share to
+  // parameters of a clone of func, or returns func if there are none
+  shared_ptr<ngraph::Function> ShareWeights(
+      shared_ptr<ngraph::Function> func);
+  // Creates the IE network of func, resolves the bindings of its inputs and
+  // outputs and loads it to the device. parameters are those of the
+  // function the executable was created with, including the unused ones.
+  void LoadNetwork(shared_ptr<ngraph::Function> func,
+                   const ngraph::ParameterVector& parameters,
+                   const vector<ngraph::Shape>& input_shapes,
+                   const map<string, string>& config);
+
+  // Borrows an idle infer request from the pool, creating a new one if the
+  // pool has not reached its maximum size yet. Blocks otherwise.
+  PooledInferRequest* AcquireInferRequest();
+  // Same as AcquireInferRequest, but returns nullptr instead of blocking.
+  // m_infer_req_mutex must be held.
+  PooledInferRequest* TryAcquireInferRequest();
+  // Hands an infer request obtained from AcquireInferRequest over to the
+  // oldest queued asynchronous call, or returns it to the pool
+  void ReleaseInferRequest(PooledInferRequest* infer_req);
+  // Sets the blobs of an asynchronous call on infer_req and starts inference
+  void StartAsync(PooledInferRequest* infer_req,
+                  const vector<shared_ptr<ngraph::runtime::Tensor>>& inputs,
+                  vector<shared_ptr<ngraph::runtime::Tensor>> outputs,
+                  CallDone done, const TraceContext& trace_context);
+
+  void SetInputBlobs(PooledInferRequest& infer_req,
+                     const vector<shared_ptr<ngraph::runtime::Tensor>>& inputs);
+  void SetOutputBlobs(PooledInferRequest& infer_req,
+                      vector<shared_ptr<ngraph::runtime::Tensor>>& outputs);
+  // Sets the blob of tensor as the index-th bound blob of infer_req
+  void SetBlob(PooledInferRequest& infer_req, size_t index, const string& name,
+               const shared_ptr<ngraph::runtime::Tensor>& tensor);
+  // Wraps the blobs of outputs that were not preallocated by the caller
+  void GetOutputBlobs(InferenceEngine::InferRequest& infer_req,
+                      vector<shared_ptr<ngraph::runtime::Tensor>>& outputs);
+  void OnAsyncComplete(PooledInferRequest* infer_req,
+                       InferenceEngine::StatusCode code);
+  void RecordPerfCounters(InferenceEngine::InferRequest& infer_req);
+
   InferenceEngine::CNNNetwork m_network;
-  InferenceEngine::InferRequest m_infer_req;
+  InferenceEngine::ExecutableNetwork m_exe_network;
+  // Infer requests are created lazily from m_exe_network, so that concurrent
+  // calls to this executable do not have to queue on a single request
+  vector<unique_ptr<PooledInferRequest>> m_infer_reqs;
+  vector<PooledInferRequest*> m_idle_infer_reqs;
+  size_t m_max_infer_reqs;
+  // Asynchronous calls waiting for an infer request, oldest first
+  deque<PendingCall> m_pending_calls;
+  mutex m_infer_req_mutex;
+  condition_variable m_infer_req_cv;
   string m_device;
   // This holds the parameters we insert for functions with no input parameters
   vector<pair<string, shared_ptr<ngraph::runtime::Tensor>>> m_hoisted_params;
+  // Parameters replacing large constants, bound to blobs of SharedWeights
+  vector<pair<string, shared_ptr<ngraph::runtime::Tensor>>> m_shared_weights;
   vector<int> m_skipped_inputs;
+  // Indices of the inputs given to Call and the names of the IE inputs they
+  // are bound to, in increasing order of index
+  vector<pair<int, string>> m_input_bindings;
+  // Names of the IE outputs corresponding to the function results
+  vector<string> m_output_names;
+  bool m_perf_counters_enabled;
+  // Maps the names of IE layers to the TF nodes they were translated from
+  unordered_map<string, string> m_layer_tf_nodes;
   // This keeps track of whether the original function was trivial: either a
   // constant function, an identity function or a zero function
   shared_ptr<ngraph::Function> m_trivial_fn;
+  vector<int> m_trivial_inputs;
   // This is the original nGraph function corresponding to this executable
   shared_ptr<ngraph::Function> m_function;
+  // The function the IE network was created from, which may be a clone of
+  // m_function without its unused parameters, with constants hoisted to
+  // parameters and with its input shapes specialized
+  shared_ptr<ngraph::Function> m_ie_function;
 };
 }
 }
@@ -0,0 +1,307 @@
+/*******************************************************************************
+ * Copyright 2017-2020 Intel Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *******************************************************************************/
+
+#include <algorithm>
+
+#include "tensorflow/core/framework/graph.pb.h"
+#include "tensorflow/core/lib/hash/hash.h"
+#include "tensorflow/core/lib/strings/proto_serialization.h"
+
+#include "executable_cache.h"
+#include "log.h"
+#include "memory_tracker.h"
+#include "metrics.h"
+#include "utils.h"
+
+using namespace std;
+
+namespace tensorflow {
+namespace ngraph_bridge {
+
+// Static initializers
+ExecutableCache::EntryMap ExecutableCache::s_entries;
+unordered_map<uint64, ExecutableCache::Cluster> ExecutableCache::s_clusters;
+int64 ExecutableCache::s_bytes = 0;
+tensorflow::mutex ExecutableCache::s_mutex;
+atomic<uint64> ExecutableCache::s_use_clock{0};
+atomic<uint64> ExecutableCache::s_hits{0};
+atomic<uint64> ExecutableCache::s_misses{0};
+atomic<uint64> ExecutableCache::s_evictions{0};
+
+namespace {
+
+// Adds the rank and dimensions of inputs, which are either tensors or shapes,
+// to the signature
+template <typename T>
+void AddDims(const vector<T>& inputs, InputSignature& signature) {
+  for (const auto& input : inputs) {
+    signature.dims.push_back(input.dims());
+    for (int j = 0; j < input.dims(); j++) {
+      signature.dims.push_back(input.dim_size(j));
+    }
+  }
+  signature.hash =
+      Hash64(reinterpret_cast<const char*>(signature.dims.data()),
+             signature.dims.size() * sizeof(int64));
+}
+
+}  // namespace
+
+bool InputSignature::operator==(const InputSignature& other) const {
+  if (hash != other.hash || dims != other.dims ||
+      static_inputs.size() != other.static_inputs.size()) {
+    return false;
+  }
+  for (int i = 0; i < static_inputs.size(); i++) {
+    if (static_inputs[i].dtype() != other.static_inputs[i].dtype() ||
+        static_inputs[i].tensor_data() !=
+            other.static_inputs[i].tensor_data()) {
+      return false;
+    }
+  }
+  return true;
+}
+
+uint64 ExecutableCache::ComputeClusterKey(const Graph& graph,
+                                          const map<string, string>& config,
+                                          const string& device,
+                                          string& canonical_graph) {
+  GraphDef graph_def;
+  graph.ToGraphDef(&graph_def);
+  auto nodes = graph_def.mutable_node();
+  for (auto& node : *nodes) {
+    // The placement and cluster index of the nodes, and the names of the
+    // nodes feeding the cluster, depend on the session
+    node.clear_device();
+    node.mutable_attr()->erase("_ngraph_cluster");
+    node.mutable_attr()->erase("_prov_tag");
+  }
+  sort(nodes->begin(), nodes->end(), [](const NodeDef& a, const NodeDef& b) {
+    return a.name() < b.name();
+  });
+
+  canonical_graph.clear();
+  SerializeToStringDeterministic(graph_def, &canonical_graph);
+  for (const auto& it : config) {
+    canonical_graph.append(it.first).push_back('\0');
+    canonical_graph.append(it.second).push_back('\0');
+  }
+  // Executables are compiled for the backend that was set when the cluster
+  // was created, which may change between sessions
+  canonical_graph.append(device);
+  return Hash64(canonical_graph);
+}
+
+Status ExecutableCache::ComputeSignature(const vector<Tensor>& inputs,
+                                         const vector<bool>& input_is_static,
+                                         InputSignature& signature) {
+  AddDims(inputs, signature);
+  for (int i = 0; i < inputs.size(); i++) {
+    if (!input_is_static[i]) {
+      continue;
+    }
+    const Tensor& input = inputs[i];
+    if (!DataTypeCanUseMemcpy(input.dtype())) {
+      return errors::Internal("Unsupported data type for static input: ",
+                              DataType_Name(input.dtype()));
+    }
+    auto data = input.tensor_data();
+    signature.static_inputs.push_back(input);
+    signature.hash =
+        Hash64Combine(signature.hash, Hash64(data.data(), data.size()));
+  }
+  return Status::OK();
+}
+
+void ExecutableCache::ComputeSignature(const vector<TensorShape>& shapes,
+                                       InputSignature& signature) {
+  AddDims(shapes, signature);
+}
+
+size_t ExecutableCache::KeyHash::operator()(const Key& key) const {
+  return Hash64Combine(key.cluster_key, key.signature.hash);
+}
+
+shared_ptr<Executable> ExecutableCache::Lookup(
+    uint64 cluster_key, const InputSignature& signature, bool count_miss) {
+  tf_shared_lock lock(s_mutex);
+  auto it = s_entries.find(Key{cluster_key, signature});
+  if (it == s_entries.end()) {
+    if (count_miss) {
+      s_misses++;
+    }
+    return nullptr;
+  }
+  s_hits++;
+  it->second.last_use.store(++s_use_clock, memory_order_relaxed);
+  return it->second.exec;
+}
+
+void ExecutableCache::Insert(uint64 cluster_key, InputSignature signature,
+                             shared_ptr<Executable> exec, int64 footprint,
+                             int cluster_id) {
+  int depth = 16;
+  auto depth_env = utils::GetEnv("NGRAPH_TF_FUNCTION_CACHE_ITEM_DEPTH");
+  if (!depth_env.empty()) {
+    depth = atoi(depth_env.c_str());
+  }
+  int64 budget = atoll(
+      utils::GetEnv("NGRAPH_TF_EXECUTABLE_CACHE_BUDGET_MB").c_str());
+  budget *= 1024 * 1024;
+
+  vector<shared_ptr<Executable>> evicted;
+  mutex_lock lock(s_mutex);
+  Key key{cluster_key, move(signature)};
+  if (s_entries.find(key) != s_entries.end()) {
+    // Another op compiled the same executable concurrently
+    return;
+  }
+
+  // Make room within the cluster
+  auto& cluster_keys = s_clusters[cluster_key].keys;
+  while (depth > 0 && cluster_keys.size() >= depth) {
+    Evict(FindLeastRecentlyUsed(&cluster_keys, nullptr), evicted);
+  }
+
+  int64 hoisted_bytes = exec->GetHoistedParamBytes();
+  auto it = s_entries
+                .emplace(piecewise_construct, forward_as_tuple(move(key)),
+                         forward_as_tuple())
+                .first;
+  auto& entry = it->second;
+  entry.exec = move(exec);
+  entry.footprint = max<int64>(footprint, 0);
+  entry.hoisted_bytes = hoisted_bytes;
+  entry.cluster_id = cluster_id;
+  entry.last_use = ++s_use_clock;
+  entry.cluster_pos = cluster_keys.insert(cluster_keys.end(), &it->first);
+  s_bytes += entry.footprint;
+  TrackMemory(entry, 1);
+
+  // Make room within the budget, never evicting the new executable
+  while (budget > 0 && s_bytes > budget && s_entries.size() > 1) {
+    Evict(FindLeastRecentlyUsed(nullptr, &entry), evicted);
+  }
+  NGRAPH_VLOG(2) << "Executable cache holds " << s_entries.size()
+                 << " executables, " << s_bytes / (1024 * 1024) << " MB";
+}
+
+void ExecutableCache::AcquireCluster(uint64& cluster_key,
+                                     const string& canonical_graph) {
+  mutex_lock lock(s_mutex);
+  // Clusters whose key is taken by another graph move on to the next key
+  for (;; cluster_key++) {
+    auto& cluster = s_clusters[cluster_key];
+    if (cluster.refs == 0) {
+      cluster.graph = canonical_graph;
+    } else if (cluster.graph != canonical_graph) {
+      NGRAPH_VLOG(1) << "Cluster key " << cluster_key
+                     << " is in use by another graph";
+      continue;
+    }
+    cluster.refs++;
+    return;
+  }
+}
+
+void ExecutableCache::ReleaseCluster(uint64 cluster_key) {
+  vector<shared_ptr<Executable>> evicted;
+  mutex_lock lock(s_mutex);
+  auto cluster = s_clusters.find(cluster_key);
+  if (cluster == s_clusters.end() || --cluster->second.refs > 0) {
+    return;
+  }
+  while (!cluster->second.keys.empty()) {
+    Erase(s_entries.find(*cluster->second.keys.back()), evicted);
+  }
+  s_clusters.erase(cluster);
+}
+
+std::mutex& ExecutableCache::GetCompileMutex(uint64 cluster_key) {
+  mutex_lock lock(s_mutex);
+  return *s_clusters[cluster_key].compile_mutex;
+}
+
+void ExecutableCache::Clear() {
+  vector<shared_ptr<Executable>> evicted;
+  mutex_lock lock(s_mutex);
+  for (auto& it : s_entries) {
+    TrackMemory(it.second, -1);
+    evicted.push_back(move(it.second.exec));
+  }
+  s_entries.clear();
+  for (auto& cluster : s_clusters) {
+    cluster.second.keys.clear();
+  }
+  s_bytes = 0;
+}
+
+ExecutableCache::Stats ExecutableCache::GetStats() {
+  tf_shared_lock lock(s_mutex);
+  return Stats{s_hits, s_misses, s_evictions, s_entries.size(),
+               static_cast<uint64>(s_bytes)};
+}
+
+void ExecutableCache::Erase(EntryMap::iterator it,
+                            vector<shared_ptr<Executable>>& evicted) {
+  auto& entry = it->second;
+  s_clusters[it->first.cluster_key].keys.erase(entry.cluster_pos);
+  s_bytes -= entry.footprint;
+  TrackMemory(entry, -1);
+  evicted.push_back(move(entry.exec));
+  s_entries.erase(it);
+}
+
+void ExecutableCache::Evict(EntryMap::iterator it,
+                            vector<shared_ptr<Executable>>& evicted) {
+  s_evictions++;
+  ClusterMetrics::Get(it->second.cluster_id).cache_evictions->Increment();
+  Erase(it, evicted);
+}
+
+ExecutableCache::EntryMap::iterator ExecutableCache::FindLeastRecentlyUsed(
+    const list<const Key*>* keys, const Entry* except) {
+  auto lru = s_entries.end();
+  uint64 lru_use = 0;
+  auto consider = [&](EntryMap::iterator it) {
+    uint64 last_use = it->second.last_use.load(memory_order_relaxed);
+    if (&it->second != except &&
+        (lru == s_entries.end() || last_use < lru_use)) {
+      lru = it;
+      lru_use = last_use;
+    }
+  };
+  if (keys == nullptr) {
+    for (auto it = s_entries.begin(); it != s_entries.end(); ++it) {
+      consider(it);
+    }
+  } else {
+    for (const Key* key : *keys) {
+      consider(s_entries.find(*key));
+    }
+  }
+  return lru;
+}
+
+void ExecutableCache::TrackMemory(const Entry& entry, int sign) {
+  MemoryTracker::Add(MemoryTracker::kExecutables, sign * entry.footprint,
+                     entry.cluster_id);
+  MemoryTracker::Add(MemoryTracker::kHoistedParams,
+                     sign * entry.hoisted_bytes, entry.cluster_id);
+}
+
+}  // namespace ngraph_bridge
+}  // namespace tensorflow
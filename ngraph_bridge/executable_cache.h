@@ -0,0 +1,178 @@
+/*******************************************************************************
+ * Copyright 2017-2020 Intel Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *******************************************************************************/
+
+#pragma once
+
+#include <atomic>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "tensorflow/core/framework/tensor.h"
+#include "tensorflow/core/framework/tensor_shape.h"
+#include "tensorflow/core/graph/graph.h"
+#include "tensorflow/core/lib/gtl/inlined_vector.h"
+#include "tensorflow/core/platform/mutex.h"
+#include "tensorflow/core/platform/types.h"
+
+#include "ngraph_bridge/executable.h"
+
+namespace tensorflow {
+namespace ngraph_bridge {
+
+// Identifies the executable for a set of inputs by the shapes of all inputs
+// and the contents of the static ones. Building and looking up a signature
+// does not allocate for clusters of typical size.
+struct InputSignature {
+  // The rank of each input followed by its dimensions
+  gtl::InlinedVector<int64, 16> dims;
+  gtl::InlinedVector<Tensor, 4> static_inputs;
+  uint64 hash = 0;
+
+  bool operator==(const InputSignature& other) const;
+};
+
+// Process-wide cache of compiled executables, shared by all encapsulate ops.
+// Executables are cached per cluster key; encapsulate ops whose clusters have
+// the same key share them. Entries are evicted least recently used first,
+// when a cluster exceeds NGRAPH_TF_FUNCTION_CACHE_ITEM_DEPTH executables
+// (default 16) or when the footprint of all executables exceeds
+// NGRAPH_TF_EXECUTABLE_CACHE_BUDGET_MB (unbounded by default). Lookups only
+// share the cache lock, so that hits of concurrent ops don't serialize.
+class ExecutableCache {
+ public:
+  struct Stats {
+    uint64 hits;
+    uint64 misses;
+    uint64 evictions;
+    uint64 entries;
+    // Sum of the footprints of the cached executables
+    uint64 bytes;
+  };
+
+  // Computes a key that is the same for clusters with identical graphs,
+  // plugin configuration and backend device, whichever session or graph
+  // they were created in, so that they share their executables. The inputs
+  // the key was hashed from are serialized into canonical_graph, which tells
+  // clusters with colliding keys apart in AcquireCluster.
+  static uint64 ComputeClusterKey(const Graph& graph,
+                                  const std::map<string, string>& config,
+                                  const string& device,
+                                  string& canonical_graph);
+  // Computes the signature of the inputs of a cluster
+  static Status ComputeSignature(const std::vector<Tensor>& inputs,
+                                 const std::vector<bool>& input_is_static,
+                                 InputSignature& signature);
+  // Computes the signature of inputs of the given shapes, for clusters
+  // without static inputs
+  static void ComputeSignature(const std::vector<TensorShape>& shapes,
+                               InputSignature& signature);
+
+  // Returns the executable cached for cluster_key and signature, or nullptr
+  // on a miss. count_miss is cleared when repeating a lookup that missed.
+  static std::shared_ptr<Executable> Lookup(uint64 cluster_key,
+                                            const InputSignature& signature,
+                                            bool count_miss = true);
+  // Caches exec, whose compilation grew the process by footprint bytes. Its
+  // memory is accounted to cluster_id in the MemoryTracker.
+  static void Insert(uint64 cluster_key, InputSignature signature,
+                     std::shared_ptr<Executable> exec, int64 footprint,
+                     int cluster_id);
+  // Registers a user of the executables cached for cluster_key. If the key
+  // is in use by a cluster with another canonical graph, cluster_key is
+  // changed to a key of its own.
+  static void AcquireCluster(uint64& cluster_key,
+                             const string& canonical_graph);
+  // Drops all executables cached for cluster_key once its last user is gone
+  static void ReleaseCluster(uint64 cluster_key);
+  // Serializes the compilation of executables for cluster_key, so that users
+  // sharing a cluster compile each signature only once. Valid while the
+  // cluster is acquired.
+  static std::mutex& GetCompileMutex(uint64 cluster_key);
+  static void Clear();
+
+  static Stats GetStats();
+
+ private:
+  struct Key {
+    uint64 cluster_key;
+    InputSignature signature;
+
+    bool operator==(const Key& other) const {
+      return cluster_key == other.cluster_key && signature == other.signature;
+    }
+  };
+
+  struct KeyHash {
+    size_t operator()(const Key& key) const;
+  };
+
+  struct Entry {
+    std::shared_ptr<Executable> exec;
+    int64 footprint = 0;
+    int64 hoisted_bytes = 0;
+    int cluster_id = -1;
+    // Value of s_use_clock when the entry was last used. Updated by lookups
+    // holding the cache lock in shared mode.
+    std::atomic<uint64> last_use{0};
+    // Position of the key in the list of its cluster
+    std::list<const Key*>::iterator cluster_pos;
+  };
+
+  struct Cluster {
+    int refs = 0;
+    // Canonical graph of the users of the cluster, as keys may collide
+    string graph;
+    // Keys of the entries of the cluster
+    std::list<const Key*> keys;
+    std::unique_ptr<std::mutex> compile_mutex{new std::mutex};
+  };
+
+  using EntryMap = std::unordered_map<Key, Entry, KeyHash>;
+
+  // Removes an entry, handing its executable over to evicted so that it is
+  // destroyed once the cache lock has been released
+  static void Erase(EntryMap::iterator it,
+                    std::vector<std::shared_ptr<Executable>>& evicted);
+  // Erases an entry to make room for another one
+  static void Evict(EntryMap::iterator it,
+                    std::vector<std::shared_ptr<Executable>>& evicted);
+  // Returns the least recently used of the entries of keys (of all entries
+  // if keys is null), other than except, or s_entries.end() if there is none.
+  // Linear, but only called when inserting, under the exclusive lock.
+  static EntryMap::iterator FindLeastRecentlyUsed(
+      const std::list<const Key*>* keys, const Entry* except);
+  // Adds the memory of entry to the MemoryTracker, or removes it if sign is
+  // negative
+  static void TrackMemory(const Entry& entry, int sign);
+
+  static EntryMap s_entries;
+  static std::unordered_map<uint64, Cluster> s_clusters;
+  static int64 s_bytes;
+  // Held in shared mode by lookups, exclusively by everything else
+  static mutex s_mutex;
+  static std::atomic<uint64> s_use_clock;
+
+  static std::atomic<uint64> s_hits;
+  static std::atomic<uint64> s_misses;
+  static std::atomic<uint64> s_evictions;
+};
+
+}  // namespace ngraph_bridge
+}  // namespace tensorflow
@@ -23,6 +23,7 @@
 #include "ie_layouts.h"
 #include "ie_precision.hpp"
 #include "ie_tensor.h"
+#include "memory_tracker.h"
 
 using namespace ngraph;
 using namespace std;
@@ -30,6 +31,30 @@ using namespace std;
 namespace tensorflow {
 namespace ngraph_bridge {
 
+// Hands out memory owned by someone else to a blob. The memory can be
+// changed between uses of the blob.
+class ExternalMemoryAllocator : public InferenceEngine::IAllocator {
+ public:
+  explicit ExternalMemoryAllocator(void* memory_pointer)
+      : m_memory_pointer(memory_pointer) {}
+
+  void* lock(void*, InferenceEngine::LockOp) noexcept override {
+    return m_memory_pointer;
+  }
+  void unlock(void*) noexcept override {}
+  // The handle is never dereferenced, it only needs to be non-null
+  void* alloc(size_t) noexcept override { return this; }
+  bool free(void*) noexcept override { return true; }
+  void Release() noexcept override { delete this; }
+
+  void set_memory_pointer(void* memory_pointer) {
+    m_memory_pointer = memory_pointer;
+  }
+
+ private:
+  void* m_memory_pointer;
+};
+
 static InferenceEngine::Precision toPrecision(
     const element::Type& element_type) {
   switch (element_type) {
@@ -94,54 +119,58 @@ IETensor::IETensor(const element::Type& element_type, const Shape& shape_,
       InferenceEngine::TensorDesc::getLayoutByDims(shape);
 
   auto desc = InferenceEngine::TensorDesc(precision, shape, layout);
-  auto size = shape_size(shape_) * element_type.size();
+  if (memory_pointer != nullptr) {
+    m_allocator = make_shared<ExternalMemoryAllocator>(memory_pointer);
+  }
 
-#define MAKE_IE_BLOB(type_, desc_, ptr_, size_)                               \
+#define MAKE_IE_BLOB(type_, desc_, allocator_)                                \
   do {                                                                        \
-    if (ptr_ == nullptr) {                                                    \
-      m_blob = make_shared<InferenceEngine::TBlob<type_>>(desc);              \
+    if (allocator_ == nullptr) {                                              \
+      m_blob = make_shared<InferenceEngine::TBlob<type_>>(desc_);             \
     } else {                                                                  \
-      m_blob = make_shared<InferenceEngine::TBlob<type_>>(desc, (type_*)ptr_, \
-                                                          size);              \
+      m_blob = make_shared<InferenceEngine::TBlob<type_>>(desc_, allocator_); \
     }                                                                         \
   } while (0)
 
   switch (element_type) {
     case element::Type_t::f32:
-      MAKE_IE_BLOB(float, desc, memory_pointer, size);
+      MAKE_IE_BLOB(float, desc, m_allocator);
       break;
     case element::Type_t::u8:
-      MAKE_IE_BLOB(uint8_t, desc, memory_pointer, size);
+      MAKE_IE_BLOB(uint8_t, desc, m_allocator);
       break;
     case element::Type_t::i8:
-      MAKE_IE_BLOB(int8_t, desc, memory_pointer, size);
+      MAKE_IE_BLOB(int8_t, desc, m_allocator);
       break;
     case element::Type_t::u16:
-      MAKE_IE_BLOB(uint16_t, desc, memory_pointer, size);
+      MAKE_IE_BLOB(uint16_t, desc, m_allocator);
       break;
     case element::Type_t::i16:
-      MAKE_IE_BLOB(int16_t, desc, memory_pointer, size);
+      MAKE_IE_BLOB(int16_t, desc, m_allocator);
       break;
     case element::Type_t::i32:
-      MAKE_IE_BLOB(int32_t, desc, memory_pointer, size);
+      MAKE_IE_BLOB(int32_t, desc, m_allocator);
       break;
     case element::Type_t::u64:
-      MAKE_IE_BLOB(uint64_t, desc, memory_pointer, size);
+      MAKE_IE_BLOB(uint64_t, desc, m_allocator);
       break;
     case element::Type_t::i64:
-      MAKE_IE_BLOB(int64_t, desc, memory_pointer, size);
+      MAKE_IE_BLOB(int64_t, desc, m_allocator);
       break;
     case element::Type_t::boolean:
-      MAKE_IE_BLOB(uint8_t, desc, memory_pointer, size);
+      MAKE_IE_BLOB(uint8_t, desc, m_allocator);
       break;
     default:
       THROW_IE_EXCEPTION << "Can't create IE blob for type " << element_type
                          << " and shape " << shape_;
   }
-#undef MAKE_IE_TBLOB
+#undef MAKE_IE_BLOB
 
-  if (memory_pointer == nullptr) {
-    m_blob->allocate();
+  // Blobs over external memory only get a handle from the allocator
+  m_blob->allocate();
+  if (m_allocator == nullptr) {
+    m_allocated_bytes = m_blob->byteSize();
+    MemoryTracker::Add(MemoryTracker::kBlobs, m_allocated_bytes);
   }
 }
 
@@ -160,7 +189,10 @@ IETensor::IETensor(InferenceEngine::Blob::Ptr blob)
           Shape(blob->getTensorDesc().getDims()), "")),
       m_blob(blob) {}
 
-IETensor::~IETensor() { m_blob->deallocate(); }
+IETensor::~IETensor() {
+  m_blob->deallocate();
+  MemoryTracker::Add(MemoryTracker::kBlobs, -m_allocated_bytes);
+}
 
 void IETensor::write(const void* src, size_t bytes) {
   const int8_t* src_ptr = static_cast<const int8_t*>(src);
@@ -186,6 +218,13 @@ void IETensor::read(void* dst, size_t bytes) const {
   copy(output_ptr, output_ptr + bytes, dst_ptr);
 }
 
+void IETensor::Rebind(void* memory_pointer) {
+  if (m_allocator == nullptr) {
+    throw runtime_error("Only tensors over external memory can be rebound");
+  }
+  m_allocator->set_memory_pointer(memory_pointer);
+}
+
 const void* IETensor::get_data_ptr() const {
   auto blob = InferenceEngine::as<InferenceEngine::MemoryBlob>(m_blob);
   auto lm = blob->rwmap();
@@ -25,6 +25,8 @@
 namespace tensorflow {
 namespace ngraph_bridge {
 
+class ExternalMemoryAllocator;
+
 class IETensor : public ngraph::runtime::Tensor {
  public:
   IETensor(const ngraph::element::Type& element_type,
@@ -42,11 +44,22 @@ class IETensor : public ngraph::runtime::Tensor {
   const void* get_data_ptr() const;
   InferenceEngine::Blob::Ptr get_blob() { return m_blob; }
 
+  // Points a tensor created over external memory at memory_pointer, which
+  // must be as large as the tensor. The blob is kept, so infer requests it
+  // was set on only need it to be set again.
+  void Rebind(void* memory_pointer);
+  // Whether the tensor was created over external memory and can be rebound
+  bool IsRebindable() const { return m_allocator != nullptr; }
+
  private:
   IETensor(const IETensor&) = delete;
   IETensor(IETensor&&) = delete;
   IETensor& operator=(const IETensor&) = delete;
+  // Provides the memory of blobs over external memory
+  std::shared_ptr<ExternalMemoryAllocator> m_allocator;
   InferenceEngine::Blob::Ptr m_blob;
+  // Bytes of the blob if it was allocated by this tensor
+  int64 m_allocated_bytes = 0;
 };
 
 // A simple TensorBuffer implementation that allows us to create Tensors that
@@ -13,60 +13,185 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  *******************************************************************************/
+#include <algorithm>
+#include <condition_variable>
 #include <cstdlib>
+#include <functional>
+#include <list>
+#include <map>
 #include <mutex>
+#include <set>
 #include <utility>
 
 #include "tensorflow/core/common_runtime/dma_helper.h"
 #include "tensorflow/core/common_runtime/function.h"
 #include "tensorflow/core/common_runtime/graph_constructor.h"
 #include "tensorflow/core/common_runtime/optimization_registry.h"
+#include "tensorflow/core/common_runtime/process_function_library_runtime.h"
 #include "tensorflow/core/framework/attr_value.pb.h"
 #include "tensorflow/core/framework/graph.pb.h"
+#include "tensorflow/core/framework/graph_to_functiondef.h"
 #include "tensorflow/core/framework/node_def_util.h"
 #include "tensorflow/core/framework/op.h"
 #include "tensorflow/core/framework/op_kernel.h"
 #include "tensorflow/core/framework/tensor.h"
+#include "tensorflow/core/framework/tensor_util.h"
 #include "tensorflow/core/graph/graph.h"
+#include "tensorflow/core/lib/gtl/cleanup.h"
+#include "tensorflow/core/lib/gtl/inlined_vector.h"
+#include "tensorflow/core/platform/cpu_info.h"
+#include "tensorflow/core/platform/threadpool.h"
 
 #include "ngraph_bridge/backend_manager.h"
+#include "ngraph_bridge/call_bindings.h"
 #include "ngraph_bridge/cluster_manager.h"
+#include "ngraph_bridge/default_opset.h"
+#include "ngraph_bridge/executable_cache.h"
 #include "ngraph_bridge/ie_tensor.h"
 #include "ngraph_bridge/log.h"
 #include "ngraph_bridge/mark_for_clustering.h"
+#include "ngraph_bridge/memory_tracker.h"
+#include "ngraph_bridge/metrics.h"
 #include "ngraph_bridge/ngraph_builder.h"
+#include "ngraph_bridge/perf_counters.h"
 #include "ngraph_bridge/tf_utils.h"
 #include "ngraph_bridge/timer.h"
+#include "ngraph_bridge/tracer.h"
 #include "ngraph_bridge/utils.h"
+#include "ngraph_bridge/warmup.h"
 
 using namespace std;
 
 namespace tensorflow {
 namespace ngraph_bridge {
 
-class NGraphEncapsulateOp : public OpKernel {
+// A TensorBuffer that aliases the data of an nGraph constant and keeps the
+// constant alive. The memory is reported as not owned so that TF never
+// forwards it to a downstream op that would write into it.
+class ConstantTensorBuffer : public TensorBuffer {
+ public:
+  ConstantTensorBuffer(std::shared_ptr<opset::Constant> constant)
+      : TensorBuffer(const_cast<void*>(constant->get_data_ptr())),
+        size_(ngraph::shape_size(constant->get_shape()) *
+              constant->get_element_type().size()),
+        constant_(constant) {}
+
+  size_t size() const override { return size_; }
+
+  TensorBuffer* root_buffer() override { return this; }
+
+  void FillAllocationDescription(AllocationDescription* proto) const override {
+    proto->set_allocated_bytes(size_);
+  }
+
+  bool OwnsMemory() const override { return false; }
+
+ private:
+  size_t size_;
+  std::shared_ptr<opset::Constant> constant_;
+};
+
+class NGraphEncapsulateOp : public AsyncOpKernel {
  public:
   explicit NGraphEncapsulateOp(OpKernelConstruction* ctx);
   ~NGraphEncapsulateOp() override;
-  void Compute(OpKernelContext* ctx) override;
+  void ComputeAsync(OpKernelContext* ctx, DoneCallback done) override;
 
  private:
+  // Looks up the executable for the inputs, compiling it on a miss. With
+  // background compilation, a miss schedules the compilation and returns a
+  // null executable instead.
   Status GetExecutable(const std::vector<Tensor>& tf_input_tensors,
                        std::shared_ptr<Executable>& ng_exec);
+  // Returns the function translated with dynamic shapes for the values of
+  // the static inputs in signature, translating it on first use. Returns
+  // null if the cluster can't be translated with dynamic shapes.
+  std::shared_ptr<ngraph::Function> GetSymbolicFunction(
+      const std::vector<Tensor>& tf_input_tensors,
+      const InputSignature& signature);
+  // Translates and compiles the executable for the inputs and caches it
+  Status CompileExecutable(const std::vector<Tensor>& tf_input_tensors,
+                           InputSignature signature,
+                           std::shared_ptr<Executable>& ng_exec);
+  // Compiles the executable for the inputs on the background compile pool,
+  // unless it is already being compiled or the cluster has as many
+  // compilations pending as the pool has threads. Calls run the TF subgraph
+  // until their executable is ready.
+  void ScheduleCompile(const std::vector<Tensor>& tf_input_tensors,
+                       const InputSignature& signature);
+  // The threads compiling executables in the background, shared by all
+  // clusters
+  static thread::ThreadPool* GetCompilePool();
+  // Prepares running the TF subgraph of the cluster while executables are
+  // compiled in the background
+  Status InstantiateFallback(OpKernelConstruction* ctx);
+  // Runs the TF subgraph of the cluster on the inputs of ctx
+  void RunFallback(OpKernelContext* ctx, DoneCallback done);
+  // Sets the outputs of a trivial executable without running it. unpad maps
+  // tensors of the padded batch size back to the actual one.
+  Status ForwardTrivialResults(
+      OpKernelContext* ctx, const std::shared_ptr<Executable>& ng_exec,
+      const std::function<Tensor(const Tensor&)>& unpad);
+  // Returns the size of the batch bucket the inputs fall in, or -1 if they
+  // are not bucketed. batch_size is set to the batch size of the inputs.
+  int64 GetBatchBucket(const std::vector<Tensor>& tf_input_tensors,
+                       int64& batch_size);
 
   std::mutex m_compute_lock_;
   Graph m_graph;
   int m_cluster_id;
-  int m_function_cache_depth_in_items = 16;
+  // When set, inference is started with InferRequest::StartAsync and the TF
+  // inter-op thread is released while the cluster executes
+  bool m_async_execution = false;
+  // Identifies the executables of this op in the ExecutableCache. Ops of
+  // identical clusters share the same key.
+  uint64 m_cache_key = 0;
+  bool m_cache_key_acquired = false;
+  // The backend executables are compiled for, which is part of the cache key
+  std::shared_ptr<Backend> m_backend;
   string m_name;
   std::vector<bool> m_input_is_static;
-  std::list<std::string> m_lru;
-  std::unordered_map<std::string, std::shared_ptr<Executable>> m_ng_exec_map;
+  std::map<std::string, std::string> m_device_config;
+  // Functions translated with dynamic input shapes, keyed by the values of
+  // the static inputs, most recently used first. New shapes only specialize
+  // them instead of translating the cluster again.
+  struct SymbolicFunction {
+    gtl::InlinedVector<Tensor, 4> static_inputs;
+    std::shared_ptr<ngraph::Function> function;
+  };
+  std::list<SymbolicFunction> m_symbolic_functions;
+  // Set with NGRAPH_TF_SYMBOLIC_TRANSLATION=1, cleared once the cluster
+  // failed to translate with dynamic shapes
+  bool m_symbolic_translation = false;
+  // When set, symbolic functions are specialized by reshaping the IE network
+  // rather than the nGraph function
+  bool m_dynamic_shapes = false;
+  // Batch sizes inputs are padded up to, either powers of two or a sorted
+  // list of buckets. Inputs are not padded if neither is set.
+  bool m_batch_bucket_pow2 = false;
+  std::vector<int64> m_batch_buckets;
+  // With background compilation, the TF subgraph of the cluster is run in a
+  // private function library runtime until its executable is ready
+  std::unique_ptr<FunctionLibraryDefinition> m_fallback_flib_def;
+  std::unique_ptr<ProcessFunctionLibraryRuntime> m_fallback_pflr;
+  FunctionLibraryRuntime* m_fallback_flr = nullptr;
+  FunctionLibraryRuntime::Handle m_fallback_handle = kInvalidHandle;
+  // Hashes of the signatures being compiled in the background, and of those
+  // that failed to compile. Failed signatures are compiled in the foreground
+  // so that the error reaches the caller.
+  std::set<uint64> m_pending_signatures;
+  std::set<uint64> m_failed_signatures;
+  std::mutex m_pending_mutex;
+  std::condition_variable m_pending_cv;
+  // Tensors wrapping the inputs and outputs of previous calls, rebound to
+  // the memory of new calls
+  CallBindingsPool m_call_bindings{8};
+  ClusterMetrics m_metrics;
 };
 
 static Status ParseNodeAttributes(
     const google::protobuf::Map<string, AttrValue>& additional_attributes,
-    std::unordered_map<std::string, std::string>* additional_attribute_map) {
+    std::map<std::string, std::string>* additional_attribute_map) {
   for (auto itx : additional_attributes) {
     // Find the optional attributes to be sent to the backend.
     // The optional attributes have '_ngraph_' appended to the start
@@ -74,7 +199,10 @@ static Status ParseNodeAttributes(
     // since the backend will only look for that.
     // '_ngraph_' is only appended for the bridge.
     // For e.g. _ngraph_ice_cores --> ice_cores
-    if (itx.first.find("_ngraph_") != std::string::npos) {
+    // Only string attributes are configuration, others such as
+    // _ngraph_static_inputs are used by the bridge itself
+    if (itx.first.find("_ngraph_") != std::string::npos &&
+        itx.second.value_case() == AttrValue::kS) {
       // TODO: decide what the node attributes should be.
       // right now _ngraph_ is used for optional attributes
       auto attr_name = itx.first;
@@ -89,11 +217,14 @@ static Status ParseNodeAttributes(
 }
 
 NGraphEncapsulateOp::NGraphEncapsulateOp(OpKernelConstruction* ctx)
-    : OpKernel(ctx), m_graph(OpRegistry::Global()) {
+    : AsyncOpKernel(ctx), m_graph(OpRegistry::Global()) {
   NGRAPH_VLOG(1) << "Create Executor " << name();
   m_name = name();
+  m_async_execution = utils::GetEnv("NGRAPH_TF_ASYNC_EXECUTION") == "1";
 
   OP_REQUIRES_OK(ctx, ctx->GetAttr<int>("ngraph_cluster", &m_cluster_id));
+  m_metrics = ClusterMetrics::Get(m_cluster_id);
+  Metrics::StartPeriodicDump();
   std::ostringstream oss;
   oss << "Encapsulate_" << m_cluster_id << ": " << name();
 
@@ -180,44 +311,152 @@ NGraphEncapsulateOp::NGraphEncapsulateOp(OpKernelConstruction* ctx)
     m_input_is_static[index] = is_static;
   }
 
-  // Get the optional attributes
-  std::unordered_map<std::string, std::string> additional_attribute_map;
+  // Inputs that are static become constants of the translated function, so
+  // clusters with static inputs are translated for each of their values.
+  // Reshaping the IE network is only used for clusters without any.
+  bool has_static_inputs =
+      std::any_of(m_input_is_static.begin(), m_input_is_static.end(),
+                  [](bool is_static) { return is_static; });
+  m_dynamic_shapes =
+      utils::GetEnv("NGRAPH_TF_DYNAMIC_SHAPES") == "1" && !has_static_inputs;
+  // Reshaping the IE network needs the symbolically translated function
+  m_symbolic_translation =
+      utils::GetEnv("NGRAPH_TF_SYMBOLIC_TRANSLATION") == "1" ||
+      m_dynamic_shapes;
+
+  // Static inputs usually describe shapes, which padding the batch dimension
+  // would invalidate
+  auto batch_buckets = utils::GetEnv("NGRAPH_TF_BATCH_BUCKETS");
+  if (!batch_buckets.empty() && !has_static_inputs) {
+    if (batch_buckets == "pow2") {
+      m_batch_bucket_pow2 = true;
+    } else {
+      for (const auto& bucket : ngraph::split(batch_buckets, ',')) {
+        if (atoll(bucket.c_str()) > 0) {
+          m_batch_buckets.push_back(atoll(bucket.c_str()));
+        }
+      }
+      std::sort(m_batch_buckets.begin(), m_batch_buckets.end());
+    }
+  }
+
+  // Get the optional attributes, which are passed on to the backend as
+  // plugin configuration
   auto node_def = ctx->def();
-  OP_REQUIRES_OK(
-      ctx, ParseNodeAttributes(node_def.attr(), &additional_attribute_map));
+  OP_REQUIRES_OK(ctx, ParseNodeAttributes(node_def.attr(), &m_device_config));
+
+  if (utils::GetEnv("NGRAPH_TF_BACKGROUND_COMPILE") == "1") {
+    auto status = InstantiateFallback(ctx);
+    if (!status.ok()) {
+      NGRAPH_VLOG(0) << "Compiling " << m_name
+                     << " in the foreground, unable to instantiate its TF "
+                        "subgraph: "
+                     << status.error_message();
+      m_fallback_handle = kInvalidHandle;
+    }
+  }
+
+  try {
+    m_backend = BackendManager::GetBackend();
+  } catch (const std::exception& exp) {
+    OP_REQUIRES_OK(ctx, errors::Internal(exp.what()));
+  }
+  string canonical_graph;
+  m_cache_key = ExecutableCache::ComputeClusterKey(
+      m_graph, m_device_config, m_backend->Name(), canonical_graph);
+  ExecutableCache::AcquireCluster(m_cache_key, canonical_graph);
+  m_cache_key_acquired = true;
+  NGRAPH_VLOG(1) << "Cluster " << m_cluster_id << " has cache key "
+                 << m_cache_key;
+  Precompiler::Claim(m_cluster_id);
+  MemoryTracker::StartSampling();
 }
 
 NGraphEncapsulateOp::~NGraphEncapsulateOp() {
   std::ostringstream oss;
   oss << "Destroy Encapsulate_" << m_cluster_id << ": " << name();
   NGRAPH_VLOG(2) << "~NGraphEncapsulateOp::" << name();
-  m_ng_exec_map.clear();
+  {
+    // Background compilations refer to this op
+    std::unique_lock<std::mutex> lock(m_pending_mutex);
+    m_pending_cv.wait(lock, [this] { return m_pending_signatures.empty(); });
+  }
+  if (m_cache_key_acquired) {
+    ExecutableCache::ReleaseCluster(m_cache_key);
+  }
 }
 
-void NGraphEncapsulateOp::Compute(OpKernelContext* ctx) {
+void NGraphEncapsulateOp::ComputeAsync(OpKernelContext* ctx,
+                                       DoneCallback done) {
   NGRAPH_VLOG(1) << "Compute using executor " << name();
-  std::ostringstream oss;
-  oss << "Execute: Encapsulate_" << m_cluster_id << ": " << name();
   NGRAPH_VLOG(4) << "NGraphEncapsulateOp::Compute starting for cluster "
                  << m_cluster_id;
 
+  Tracer::ContextScope trace_context(m_cluster_id, ctx->step_id());
   Timer compute_time;
-  std::lock_guard<std::mutex> lock(m_compute_lock_);
   int time_func_create_or_lookup;
   Timer function_lookup_or_create;
 
-  // TF input tensor
-  std::vector<Tensor> tf_input_tensors;
+  // TF input tensor. The vector is reused by the calls on this thread, so
+  // that its storage is not allocated each time.
+  static thread_local std::vector<Tensor> tf_input_tensors;
+  tf_input_tensors.clear();
+  auto release_inputs = gtl::MakeCleanup([] { tf_input_tensors.clear(); });
   std::shared_ptr<Executable> ng_exec;
   int step_id;
   for (int i = 0; i < ctx->num_inputs(); i++) {
     tf_input_tensors.push_back(ctx->input(i));
   }
 
+  // Pad the batch dimension of the inputs up to their bucket, so that batch
+  // sizes falling in the same bucket share an executable. Outputs are sliced
+  // back to the batch size once the cluster has run.
+  int64 batch_size = -1;
+  int64 bucket_size = GetBatchBucket(tf_input_tensors, batch_size);
+  bool bucketed = bucket_size > batch_size;
+  if (bucketed) {
+    NGRAPH_VLOG(4) << "Padding batch of " << batch_size << " to "
+                   << bucket_size << " for cluster " << m_cluster_id;
+    for (auto& input : tf_input_tensors) {
+      TensorShape padded_shape = input.shape();
+      padded_shape.set_dim(0, bucket_size);
+      Tensor padded;
+      OP_REQUIRES_OK_ASYNC(
+          ctx, ctx->allocate_temp(input.dtype(), padded_shape, &padded), done);
+      auto data = static_cast<char*>(DMAHelper::base(&padded));
+      memcpy(data, DMAHelper::base(&input), input.TotalBytes());
+      m_metrics.bytes_copied->Increment(input.TotalBytes());
+      memset(data + input.TotalBytes(), 0,
+             padded.TotalBytes() - input.TotalBytes());
+      input = padded;
+    }
+  }
+  // Captures are kept small enough for std::function to store them inline
+  std::function<Tensor(const Tensor&)> unpad =
+      [batch_size, bucket_size](const Tensor& tensor) -> Tensor {
+        if (bucket_size > batch_size && tensor.dims() > 0 &&
+            tensor.dim_size(0) == bucket_size) {
+          return tensor.Slice(0, batch_size);
+        }
+        return tensor;
+      };
+
   step_id = ctx->step_id();
 
-  // Get ngraph executable and inputs information
-  OP_REQUIRES_OK(ctx, GetExecutable(tf_input_tensors, ng_exec));
+  // Get ngraph executable and inputs information. Only the executable cache
+  // needs to be guarded; the executable itself owns a pool of infer requests
+  // and can be called concurrently.
+  {
+    std::lock_guard<std::mutex> lock(m_compute_lock_);
+    OP_REQUIRES_OK_ASYNC(ctx, GetExecutable(tf_input_tensors, ng_exec), done);
+  }
+  if (ng_exec == nullptr) {
+    m_metrics.fallback_runs->Increment();
+    NGRAPH_VLOG(1) << "Running the TF subgraph of " << name()
+                   << " while its executable is compiled";
+    RunFallback(ctx, done);
+    return;
+  }
 
   NGRAPH_VLOG(1) << " Step_ID: " << step_id;
   NGRAPH_VLOG(4)
@@ -226,26 +465,48 @@ void NGraphEncapsulateOp::Compute(OpKernelContext* ctx) {
 
   time_func_create_or_lookup = function_lookup_or_create.ElapsedInMS();
 
+  // Results of trivial functions are either inputs or constants, which are
+  // handed to TF as they are instead of being copied
+  if (ng_exec->IsTrivial()) {
+    OP_REQUIRES_OK_ASYNC(ctx, ForwardTrivialResults(ctx, ng_exec, unpad),
+                         done);
+    NGRAPH_VLOG(1) << "NGRAPH_TF_TIMING_PROFILE: OP_ID: " << m_cluster_id
+                   << " Step_ID: " << step_id << " Cluster: " << name()
+                   << " Time-Compute: " << compute_time.ElapsedInMS()
+                   << " Function-Create-or-Lookup: "
+                   << time_func_create_or_lookup << " Forwarded";
+    done();
+    return;
+  }
+
   NGRAPH_VLOG(4) << "NGraphEncapsulateOp::Compute got graph for cluster "
                  << m_cluster_id;
 
   Timer create_or_lookup_tensors;
-  vector<shared_ptr<ngraph::runtime::Tensor>> ng_inputs;
-  int ng_input_tensor_size_in_bytes = 0;
+  const auto& results = ng_exec->GetResults();
+  // The tensors of a previous call are reused, so that steady-state calls
+  // only point them at the memory of this call
+  auto bindings = m_call_bindings.Acquire(ng_exec, tf_input_tensors.size(),
+                                          results.size());
+  auto& ng_inputs = bindings->inputs;
+  auto& ng_outputs = bindings->outputs;
+  int64 ng_input_tensor_size_in_bytes = 0;
   // Allocate tensors for input arguments.
-  for (int i = 0; i < tf_input_tensors.size(); i++) {
-    ngraph::Shape ng_shape(tf_input_tensors[i].shape().dims());
-    for (int j = 0; j < tf_input_tensors[i].shape().dims(); ++j) {
-      ng_shape[j] = tf_input_tensors[i].shape().dim_size(j);
+  {
+    TraceSpan span("BindInputs");
+    for (int i = 0; i < tf_input_tensors.size(); i++) {
+      ngraph::element::Type ng_element_type;
+      OP_REQUIRES_OK_ASYNC(ctx,
+                           tf_utils::TFDataTypeToNGraphElementType(
+                               tf_input_tensors[i].dtype(), &ng_element_type),
+                           done);
+      OP_REQUIRES_OK_ASYNC(
+          ctx, bindings->BindInput(i, ng_element_type,
+                                   tf_input_tensors[i].shape(),
+                                   tf_input_tensors[i].data()),
+          done);
+      ng_input_tensor_size_in_bytes += tf_input_tensors[i].TotalBytes();
     }
-    ngraph::element::Type ng_element_type;
-    OP_REQUIRES_OK(ctx, tf_utils::TFDataTypeToNGraphElementType(
-                            tf_input_tensors[i].dtype(), &ng_element_type));
-
-    auto backend = BackendManager::GetBackend();
-    std::shared_ptr<ngraph::runtime::Tensor> ng_tensor = make_shared<IETensor>(
-        ng_element_type, ng_shape, tf_input_tensors[i].data());
-    ng_inputs.push_back(ng_tensor);
   }
 
   NGRAPH_VLOG(4) << "NGraphEncapsulateOp::Compute allocated argument tensors "
@@ -254,204 +515,540 @@ void NGraphEncapsulateOp::Compute(OpKernelContext* ctx) {
 
   // Allocate tensors for the output results.
 
-  auto results = ng_exec->GetResults();
-  std::vector<shared_ptr<ngraph::runtime::Tensor>> ng_outputs(results.size(),
-                                                              nullptr);
   std::vector<int> dyn_shape_tensors;
-  for (auto i = 0; i < results.size(); i++) {
-    auto ng_element = results[i];
-    if (ng_element->get_output_partial_shape(0).is_dynamic()) {
-      NGRAPH_VLOG(4)
-          << "NGraphEncapsulateOp::Compute skipping output allocation for "
-             "dynamic tensor at index"
-          << i;
-      dyn_shape_tensors.push_back(i);
-      continue;
-    }
+  // Outputs of bucketed runs have the size of the bucket, so they are
+  // allocated as temporaries and sliced into the actual outputs
+  std::vector<Tensor> padded_outputs(bucketed ? results.size() : 0);
+  {
+    TraceSpan span("BindOutputs");
+    for (auto i = 0; i < results.size(); i++) {
+      const auto& ng_element = results[i];
+      if (ng_element->get_output_partial_shape(0).is_dynamic()) {
+        NGRAPH_VLOG(4)
+            << "NGraphEncapsulateOp::Compute skipping output allocation for "
+               "dynamic tensor at index"
+            << i;
+        dyn_shape_tensors.push_back(i);
+        // The executable creates the output tensor once its shape is known
+        ng_outputs[i] = nullptr;
+        continue;
+      }
 
-    // Create the TF output tensor
-    auto ng_shape = ng_element->get_shape();
-    TensorShape tf_shape;
-    for (auto dim : ng_shape) {
-      tf_shape.AddDim(dim);
+      // Create the TF output tensor
+      const auto& ng_shape = ng_element->get_shape();
+      TensorShape tf_shape;
+      for (auto dim : ng_shape) {
+        tf_shape.AddDim(dim);
+      }
+      Tensor* output_tensor = nullptr;
+      if (bucketed) {
+        output_tensor = &padded_outputs[i];
+        OP_REQUIRES_OK_ASYNC(ctx,
+                             ctx->allocate_temp(ctx->expected_output_dtype(i),
+                                                tf_shape, output_tensor),
+                             done);
+      } else {
+        OP_REQUIRES_OK_ASYNC(
+            ctx, ctx->allocate_output(i, tf_shape, &output_tensor), done);
+      }
+
+      // Make sure the nGraph-inferred element type agrees with what TensorFlow
+      // expected.
+      ngraph::element::Type expected_elem_type;
+      auto ng_element_type = ng_element->get_element_type();
+      OP_REQUIRES_OK_ASYNC(
+          ctx, tf_utils::TFDataTypeToNGraphElementType(
+                   ctx->expected_output_dtype(i), &expected_elem_type),
+          done);
+      OP_REQUIRES_ASYNC(
+          ctx, ng_element_type == expected_elem_type,
+          errors::Internal("Element type inferred by nGraph does not match "
+                           "the element type expected by TensorFlow"),
+          done);
+      OP_REQUIRES_OK_ASYNC(ctx,
+                           bindings->BindOutput(i, ng_element_type, tf_shape,
+                                                output_tensor->data()),
+                           done);
     }
-    Tensor* output_tensor = nullptr;
-    OP_REQUIRES_OK(ctx, ctx->allocate_output(i, tf_shape, &output_tensor));
-
-    // Make sure the nGraph-inferred element type agrees with what TensorFlow
-    // expected.
-    ngraph::element::Type expected_elem_type;
-    auto ng_element_type = ng_element->get_element_type();
-    OP_REQUIRES_OK(ctx,
-                   tf_utils::TFDataTypeToNGraphElementType(
-                       ctx->expected_output_dtype(i), &expected_elem_type));
-    OP_REQUIRES(
-        ctx, ng_element_type == expected_elem_type,
-        errors::Internal("Element type inferred by nGraph does not match "
-                         "the element type expected by TensorFlow"));
-    ng_outputs[i] =
-        make_shared<IETensor>(ng_element_type, ng_shape, output_tensor->data());
   }
   NGRAPH_VLOG(4)
       << "NGraphEncapsulateOp::Compute allocated result tensors for cluster "
       << m_cluster_id;
 
   int time_create_or_lookup_tensors = create_or_lookup_tensors.ElapsedInMS();
-  // Execute the nGraph function.
-  int time_execute_function;
-  {
-    Timer execute_function;
-    NGRAPH_VLOG(4) << "NGraphEncapsulateOp::Compute call starting for cluster "
-                   << m_cluster_id;
-    try {
-      ng_exec->Call(ng_inputs, ng_outputs);
-    } catch (const std::exception& exp) {
-      string status_string = "Caught exception while executing cluster " +
-                             to_string(m_cluster_id) + ": " +
-                             string(exp.what());
-      OP_REQUIRES(ctx, false, errors::Internal(status_string));
-    } catch (...) {
+
+  // Publishes the results of the nGraph call to TF once it has completed,
+  // either inline or from an Inference Engine completion callback
+  Timer execute_function;
+  auto finish = [this, ctx, step_id, compute_time, execute_function,
+                 time_func_create_or_lookup, time_create_or_lookup_tensors,
+                 ng_input_tensor_size_in_bytes, dyn_shape_tensors,
+                 padded_outputs, unpad](
+      exception_ptr error,
+      vector<shared_ptr<ngraph::runtime::Tensor>>& ng_outputs) mutable {
+    int time_execute_function = execute_function.ElapsedInMS();
+    m_metrics.execute_time->Observe(execute_function.ElapsedInMicroSec());
+    // Asynchronous calls finish on an Inference Engine thread
+    Tracer::ContextScope trace_context(m_cluster_id, step_id);
+    if (error != nullptr) {
       string status_string =
           "Caught exception while executing cluster " + to_string(m_cluster_id);
-      OP_REQUIRES(ctx, false, errors::Internal(status_string));
+      try {
+        rethrow_exception(error);
+      } catch (const std::exception& exp) {
+        status_string += ": " + string(exp.what());
+      } catch (...) {
+      }
+      ctx->SetStatus(errors::Internal(status_string));
+      return;
     }
-    time_execute_function = execute_function.ElapsedInMS();
-  }
 
-  for (auto i : dyn_shape_tensors) {
-    auto ng_output = ng_outputs[i];
-    // Create the TF output tensor
-    auto ng_shape = ng_output->get_shape();
-    TensorShape tf_shape;
-    for (auto dim : ng_shape) {
-      tf_shape.AddDim(dim);
+    TraceSpan span("WrapOutputs");
+    for (auto i : dyn_shape_tensors) {
+      auto ng_output = ng_outputs[i];
+      // Create the TF output tensor
+      auto ng_shape = ng_output->get_shape();
+      TensorShape tf_shape;
+      for (auto dim : ng_shape) {
+        tf_shape.AddDim(dim);
+      }
+
+      // Zero-copy IE tensor to TF
+      IETensorBuffer* tf_buffer =
+          new IETensorBuffer(static_pointer_cast<IETensor>(ng_output));
+      Tensor tf_tensor(ctx->expected_output_dtype(i), tf_shape, tf_buffer);
+      ctx->set_output(i, unpad(tf_tensor));
+    }
+    for (int i = 0; i < padded_outputs.size(); i++) {
+      if (padded_outputs[i].IsInitialized()) {
+        ctx->set_output(i, unpad(padded_outputs[i]));
+      }
     }
 
-    // Zero-copy IE tensor to TF
-    IETensorBuffer* tf_buffer =
-        new IETensorBuffer(static_pointer_cast<IETensor>(ng_output));
-    Tensor tf_tensor(ctx->expected_output_dtype(i), tf_shape, tf_buffer);
-    ctx->set_output(i, tf_tensor);
-  }
+    NGRAPH_VLOG(1) << "NGRAPH_TF_MEM_PROFILE:  OP_ID: " << m_cluster_id
+                   << " Step_ID: " << step_id << " Cluster: " << name()
+                   << " Input Tensors bound: "
+                   << ng_input_tensor_size_in_bytes / (1024 * 1024) << " MB"
+                   << " Total process memory: "
+                   << MemoryTracker::GetSampledRSS() / (1024 * 1024 * 1024)
+                   << " GB";
+
+    NGRAPH_VLOG(4) << "NGraphEncapsulateOp::Compute call done for cluster "
+                   << m_cluster_id;
 
-  long vm, rss;
-  utils::MemoryProfile(vm, rss);
-  NGRAPH_VLOG(1) << "NGRAPH_TF_MEM_PROFILE:  OP_ID: " << m_cluster_id
-                 << " Step_ID: " << step_id << " Cluster: " << name()
-                 << " Input Tensors created: "
-                 << ng_input_tensor_size_in_bytes / (1024 * 1024) << " MB"
-                 << " Total process memory: " << rss / (1024 * 1024) << " GB";
+    NGRAPH_VLOG(4)
+        << "NGraphEncapsulateOp::Compute done marking fresh for cluster "
+        << m_cluster_id;
+    NGRAPH_VLOG(1) << "NGRAPH_TF_TIMING_PROFILE: OP_ID: " << m_cluster_id
+                   << " Step_ID: " << step_id << " Cluster: " << name()
+                   << " Time-Compute: " << compute_time.ElapsedInMS()
+                   << " Function-Create-or-Lookup: "
+                   << time_func_create_or_lookup
+                   << " Create-and-copy-tensors: "
+                   << time_create_or_lookup_tensors
+                   << " Execute: " << time_execute_function;
+  };
 
-  NGRAPH_VLOG(4) << "NGraphEncapsulateOp::Compute call done for cluster "
+  // Execute the nGraph function.
+  NGRAPH_VLOG(4) << "NGraphEncapsulateOp::Compute call starting for cluster "
                  << m_cluster_id;
+  if (!m_async_execution) {
+    exception_ptr error;
+    try {
+      ng_exec->Call(ng_inputs, ng_outputs);
+    } catch (...) {
+      error = current_exception();
+    }
+    finish(error, ng_outputs);
+    m_call_bindings.Release(std::move(bindings));
+    done();
+    return;
+  }
 
-  NGRAPH_VLOG(4)
-      << "NGraphEncapsulateOp::Compute done marking fresh for cluster "
-      << m_cluster_id;
-  NGRAPH_VLOG(1) << "NGRAPH_TF_TIMING_PROFILE: OP_ID: " << m_cluster_id
-                 << " Step_ID: " << step_id << " Cluster: " << name()
-                 << " Time-Compute: " << compute_time.ElapsedInMS()
-                 << " Function-Create-or-Lookup: " << time_func_create_or_lookup
-                 << " Create-and-copy-tensors: "
-                 << time_create_or_lookup_tensors
-                 << " Execute: " << time_execute_function;
+  // The bindings are in use until inference completes. Padded inputs are
+  // only referenced by tf_input_tensors, which is cleared on return.
+  if (bucketed) {
+    bindings->held_inputs = tf_input_tensors;
+  }
+  auto workers = ctx->device()->tensorflow_cpu_worker_threads()->workers;
+  CallBindings* async_bindings = bindings.release();
+  auto on_complete = [this, finish, workers, done, async_bindings](
+      shared_ptr<Executable>& exec, exception_ptr error,
+      vector<shared_ptr<ngraph::runtime::Tensor>>& ng_outputs) mutable {
+    finish(error, ng_outputs);
+    async_bindings->held_inputs.clear();
+    m_call_bindings.Release(std::unique_ptr<CallBindings>(async_bindings));
+    // An executable can not be destroyed from within its own completion
+    // callback, so hand our reference over to a TF thread in case it is the
+    // last one (e.g. the executable was evicted while running)
+    workers->Schedule(
+        std::bind([](shared_ptr<Executable>&) {}, std::move(exec)));
+    done();
+  };
+  ng_exec->CallAsync(async_bindings->inputs, async_bindings->outputs,
+                     std::bind(on_complete, ng_exec, placeholders::_1,
+                               placeholders::_2));
 }  // end compute
 
 // Computes signature and gets executable
 Status NGraphEncapsulateOp::GetExecutable(
     const std::vector<Tensor>& tf_input_tensors,
     std::shared_ptr<Executable>& ng_exec) {
-  auto backend = BackendManager::GetBackend();
-
   // Compute Signature
-  std::vector<const Tensor*> static_input_map;
-  std::vector<TensorShape> input_shapes;
-  std::stringstream signature_ss;
-  for (int i = 0; i < tf_input_tensors.size(); i++) {
-    const Tensor& input_tensor = tf_input_tensors[i];
-    input_shapes.push_back(input_tensor.shape());
-    for (const auto& x : input_tensor.shape()) {
-      signature_ss << x.size << ",";
+  InputSignature signature;
+  {
+    TraceSpan span("ComputeSignature");
+    TF_RETURN_IF_ERROR(ExecutableCache::ComputeSignature(
+        tf_input_tensors, m_input_is_static, signature));
+  }
+  NGRAPH_VLOG(5) << "Computed signature: " << signature.hash;
+  {
+    TraceSpan span("CacheLookup");
+    ng_exec = ExecutableCache::Lookup(m_cache_key, signature);
+  }
+  NGRAPH_VLOG(4) << "NGraphEncapsulateOp::Compute got inputs for cluster "
+                 << m_cluster_id;
+  if (ng_exec != nullptr) {
+    m_metrics.cache_hits->Increment();
+    return Status::OK();
+  }
+  m_metrics.cache_misses->Increment();
+
+  if (m_fallback_handle != kInvalidHandle) {
+    std::lock_guard<std::mutex> lock(m_pending_mutex);
+    if (m_failed_signatures.count(signature.hash) == 0) {
+      ScheduleCompile(tf_input_tensors, signature);
+      return Status::OK();
     }
-    signature_ss << ";";
   }
-  signature_ss << "/";
+  return CompileExecutable(tf_input_tensors, std::move(signature), ng_exec);
+}
+
+thread::ThreadPool* NGraphEncapsulateOp::GetCompilePool() {
+  // Never destroyed, compilations may still be queued at exit
+  static thread::ThreadPool* pool = new thread::ThreadPool(
+      Env::Default(), "ngraph_background_compile", port::MaxParallelism());
+  return pool;
+}
+
+void NGraphEncapsulateOp::ScheduleCompile(
+    const std::vector<Tensor>& tf_input_tensors,
+    const InputSignature& signature) {
+  // m_pending_mutex is held by the caller
+  if (m_pending_signatures.count(signature.hash) != 0) {
+    return;
+  }
+  // A cluster seeing many new shapes at once must not occupy the pool, or
+  // queue compilations that hold on to copies of their inputs. The shape is
+  // scheduled again by a later call once a compilation is done.
+  auto pool = GetCompilePool();
+  if (m_pending_signatures.size() >= pool->NumThreads()) {
+    NGRAPH_VLOG(1) << "Not compiling " << m_name << " for another shape, "
+                   << m_pending_signatures.size()
+                   << " compilations are pending";
+    return;
+  }
+  m_pending_signatures.insert(signature.hash);
+  NGRAPH_VLOG(1) << "Compiling " << m_name << " in the background";
+  TraceContext context = Tracer::CurrentContext();
+  pool->Schedule([this, tf_input_tensors, signature, context]() {
+    Tracer::ContextScope trace_context(context.cluster_id, context.step_id);
+    std::shared_ptr<Executable> ng_exec;
+    auto status = CompileExecutable(tf_input_tensors, signature, ng_exec);
+    std::lock_guard<std::mutex> lock(m_pending_mutex);
+    if (!status.ok()) {
+      NGRAPH_VLOG(0) << "Background compilation of " << m_name
+                     << " failed: " << status.error_message();
+      m_failed_signatures.insert(signature.hash);
+    }
+    m_pending_signatures.erase(signature.hash);
+    m_pending_cv.notify_all();
+  });
+}
 
-  static_input_map.resize(tf_input_tensors.size());
+std::shared_ptr<ngraph::Function> NGraphEncapsulateOp::GetSymbolicFunction(
+    const std::vector<Tensor>& tf_input_tensors,
+    const InputSignature& signature) {
+  if (!m_symbolic_translation) {
+    return nullptr;
+  }
+  for (auto it = m_symbolic_functions.begin(); it != m_symbolic_functions.end();
+       ++it) {
+    bool same_values = it->static_inputs.size() ==
+                       signature.static_inputs.size();
+    for (int i = 0; same_values && i < it->static_inputs.size(); i++) {
+      const auto& a = it->static_inputs[i];
+      const auto& b = signature.static_inputs[i];
+      same_values = a.dtype() == b.dtype() && a.shape() == b.shape() &&
+                    a.tensor_data() == b.tensor_data();
+    }
+    if (same_values) {
+      m_symbolic_functions.splice(m_symbolic_functions.begin(),
+                                  m_symbolic_functions, it);
+      return it->function;
+    }
+  }
+
+  // Static inputs keep their shape, as translations depend on their values
+  std::vector<const Tensor*> static_input_map(tf_input_tensors.size());
+  std::vector<ngraph::PartialShape> dynamic_shapes;
   for (int i = 0; i < tf_input_tensors.size(); i++) {
+    const auto& shape = tf_input_tensors[i].shape();
     if (m_input_is_static[i]) {
       static_input_map[i] = &tf_input_tensors[i];
-      TF_RETURN_IF_ERROR(
-          tf_utils::TensorToStream(signature_ss, tf_input_tensors[i]));
-      signature_ss << ";";
+      ngraph::Shape ng_shape;
+      if (!tf_utils::TFTensorShapeToNGraphShape(shape, &ng_shape).ok()) {
+        return nullptr;
+      }
+      dynamic_shapes.push_back(ng_shape);
+    } else {
+      dynamic_shapes.push_back(ngraph::PartialShape::dynamic(shape.dims()));
     }
   }
+  SymbolicFunction symbolic;
+  Status status;
+  try {
+    TraceSpan span("TranslateSymbolic");
+    status = Builder::TranslateGraph(dynamic_shapes, static_input_map,
+                                     &m_graph, m_name, symbolic.function);
+  } catch (const std::exception& ex) {
+    status = errors::Internal(ex.what());
+  }
+  if (!status.ok()) {
+    NGRAPH_VLOG(1) << "Unable to translate " << m_name
+                   << " with dynamic shapes: " << status.error_message();
+    m_symbolic_translation = false;
+    m_symbolic_functions.clear();
+    return nullptr;
+  }
+  utils::DumpNGGraph(symbolic.function, m_name + "_dynamic");
 
-  string signature = signature_ss.str();
-  NGRAPH_VLOG(5) << "Computed signature: " << signature;
-  auto it = m_ng_exec_map.find(signature);
-  NGRAPH_VLOG(4) << "NGraphEncapsulateOp::Compute got inputs for cluster "
-                 << m_cluster_id;
+  // The function must not refer to the memory of the inputs
+  for (const auto& static_input : signature.static_inputs) {
+    symbolic.static_inputs.push_back(tensor::DeepCopy(static_input));
+  }
+  m_symbolic_functions.push_front(std::move(symbolic));
+  const int max_symbolic_functions = 4;
+  if (m_symbolic_functions.size() > max_symbolic_functions) {
+    m_symbolic_functions.pop_back();
+  }
+  return m_symbolic_functions.front().function;
+}
+
+Status NGraphEncapsulateOp::CompileExecutable(
+    const std::vector<Tensor>& tf_input_tensors, InputSignature signature,
+    std::shared_ptr<Executable>& ng_exec) {
+  // The executable may have been compiled when the graph was rewritten
+  Precompiler::Wait(m_cluster_id);
+  // Another op sharing the cluster may be compiling the same executable
+  std::lock_guard<std::mutex> compile_lock(
+      ExecutableCache::GetCompileMutex(m_cache_key));
+  ng_exec = ExecutableCache::Lookup(m_cache_key, signature,
+                                    /*count_miss=*/false);
 
   // Translate the TensorFlow graph to nGraph.
   std::shared_ptr<ngraph::Function> ng_function;
-  if (it == m_ng_exec_map.end()) {
+  if (ng_exec == nullptr) {
+    Timer compile_time;
+    std::vector<const Tensor*> static_input_map(tf_input_tensors.size());
+    std::vector<TensorShape> input_shapes;
+    for (int i = 0; i < tf_input_tensors.size(); i++) {
+      input_shapes.push_back(tf_input_tensors[i].shape());
+      if (m_input_is_static[i]) {
+        static_input_map[i] = &tf_input_tensors[i];
+      }
+    }
+
     // Measure the current total memory usage
     long vm, rss, vm0, rss0;
     utils::MemoryProfile(vm0, rss0);
 
     NGRAPH_VLOG(1) << "Compilation cache miss: " << m_name;
-    TF_RETURN_IF_ERROR(Builder::TranslateGraph(input_shapes, static_input_map,
-                                               &m_graph, m_name, ng_function));
-    utils::DumpNGGraph(ng_function, m_name);
-
-    // Evict the cache if the number of elements exceeds the limit
-    std::shared_ptr<Executable> evicted_ng_exec;
-    const char* cache_depth_specified =
-        std::getenv("NGRAPH_TF_FUNCTION_CACHE_ITEM_DEPTH");
-    if (cache_depth_specified != nullptr) {
-      m_function_cache_depth_in_items = atoi(cache_depth_specified);
+    auto symbolic_function = GetSymbolicFunction(tf_input_tensors, signature);
+    if (symbolic_function != nullptr && m_dynamic_shapes) {
+      std::vector<ngraph::Shape> ng_shapes(input_shapes.size());
+      for (int i = 0; i < input_shapes.size(); i++) {
+        TF_RETURN_IF_ERROR(tf_utils::TFTensorShapeToNGraphShape(
+            input_shapes[i], &ng_shapes[i]));
+      }
+      try {
+        TraceSpan span("Compile");
+        ng_exec =
+            m_backend->Compile(symbolic_function, PerfCounters::IsEnabled(),
+                               m_device_config, ng_shapes);
+      } catch (const std::exception& ex) {
+        NGRAPH_VLOG(1) << "Failed to reshape " << m_name
+                       << ", translating it for the new shapes: " << ex.what();
+      }
+    } else if (symbolic_function != nullptr) {
+      auto status = Builder::SpecializeFunction(symbolic_function,
+                                                input_shapes, ng_function);
+      if (status.ok()) {
+        try {
+          TraceSpan span("Compile");
+          ng_exec = m_backend->Compile(
+              ng_function, PerfCounters::IsEnabled(), m_device_config);
+        } catch (const std::exception& ex) {
+          status = errors::Internal(ex.what());
+        }
+      }
+      if (!status.ok()) {
+        NGRAPH_VLOG(1) << "Failed to specialize " << m_name
+                       << ", translating it for the new shapes: "
+                       << status.error_message();
+      }
     }
-    if (m_ng_exec_map.size() >= m_function_cache_depth_in_items) {
-      evicted_ng_exec = m_ng_exec_map[m_lru.back()];
-      m_ng_exec_map.erase(m_lru.back());
-
-      m_lru.pop_back();
-    }  // cache eviction if cache size greater than cache depth
 
-    try {
-      ng_exec = backend->Compile(ng_function);
-    } catch (const std::exception& ex) {
-      return errors::Internal("Failed to compile function " + m_name + ": ",
-                              ex.what());
+    if (ng_exec == nullptr) {
+      {
+        TraceSpan span("Translate");
+        TF_RETURN_IF_ERROR(Builder::TranslateGraph(
+            input_shapes, static_input_map, &m_graph, m_name, ng_function));
+      }
+      utils::DumpNGGraph(ng_function, m_name);
+      try {
+        TraceSpan span("Compile");
+        ng_exec = m_backend->Compile(ng_function, PerfCounters::IsEnabled(),
+                                     m_device_config);
+      } catch (const std::exception& ex) {
+        return errors::Internal("Failed to compile function " + m_name + ": ",
+                                ex.what());
+      }
     }
 
-    m_ng_exec_map[signature] = ng_exec;
-    m_lru.push_front(signature);
-
     // Memory after
     utils::MemoryProfile(vm, rss);
+    m_metrics.compile_time->Observe(compile_time.ElapsedInMicroSec());
     auto delta_vm_mem = vm - vm0;
     auto delta_res_mem = rss - rss0;
+
+    // The cache must not refer to the memory of the inputs. The growth of
+    // the process while compiling is accounted as the executable's footprint.
+    for (auto& static_input : signature.static_inputs) {
+      static_input = tensor::DeepCopy(static_input);
+    }
+    ExecutableCache::Insert(m_cache_key, std::move(signature), ng_exec,
+                            delta_res_mem * 1024, m_cluster_id);
+
     NGRAPH_VLOG(1) << "NGRAPH_TF_CACHE_PROFILE: OP_ID: " << m_cluster_id
-                   << " Cache length: " << m_ng_exec_map.size()
+                   << " Cache length: " << ExecutableCache::GetStats().entries
                    << " Cluster: " << m_name << " Delta VM: " << delta_vm_mem
                    << " Delta RSS: " << delta_res_mem
                    << " KB Total RSS: " << rss / (1024 * 1024) << " GB "
                    << " VM: " << vm / (1024 * 1024) << " GB" << endl;
-  }  // end of input signature not found in m_ng_exec_map
-  else {
-    // Found the input signature in m_ng_exec_map, use the cached executable
-    // Update the m_lru
-    if (signature != m_lru.front()) {
-      m_lru.remove(signature);
-      m_lru.push_front(signature);
+  }  // end of input signature not found in the executable cache
+  return Status::OK();
+}
+
+int64 NGraphEncapsulateOp::GetBatchBucket(
+    const std::vector<Tensor>& tf_input_tensors, int64& batch_size) {
+  if ((!m_batch_bucket_pow2 && m_batch_buckets.empty()) ||
+      tf_input_tensors.empty()) {
+    return -1;
+  }
+  // All inputs must share the leading dimension for it to be a batch
+  batch_size = tf_input_tensors[0].dims() > 0
+                   ? tf_input_tensors[0].dim_size(0)
+                   : 0;
+  if (batch_size == 0) {
+    return -1;
+  }
+  for (const auto& input : tf_input_tensors) {
+    if (input.dims() == 0 || input.dim_size(0) != batch_size) {
+      return -1;
+    }
+  }
+
+  if (m_batch_bucket_pow2) {
+    int64 bucket_size = 1;
+    while (bucket_size < batch_size) {
+      bucket_size <<= 1;
+    }
+    return bucket_size;
+  }
+  auto bucket = std::lower_bound(m_batch_buckets.begin(),
+                                 m_batch_buckets.end(), batch_size);
+  return bucket == m_batch_buckets.end() ? -1 : *bucket;
+}
+
+Status NGraphEncapsulateOp::ForwardTrivialResults(
+    OpKernelContext* ctx, const std::shared_ptr<Executable>& ng_exec,
+    const std::function<Tensor(const Tensor&)>& unpad) {
+  auto& results = ng_exec->GetResults();
+  auto& trivial_inputs = ng_exec->GetTrivialInputs();
+  for (int i = 0; i < results.size(); i++) {
+    if (trivial_inputs[i] >= 0) {
+      // Shares the buffer of the input tensor
+      ctx->set_output(i, ctx->input(trivial_inputs[i]));
+      continue;
+    }
+
+    TensorShape tf_shape;
+    for (auto dim : results[i]->get_shape()) {
+      tf_shape.AddDim(dim);
+    }
+    auto constant = ngraph::as_type_ptr<opset::Constant>(
+        results[i]->input_value(0).get_node_shared_ptr());
+    if (constant == nullptr) {
+      // An empty result, which has no data to copy
+      Tensor output_tensor;
+      TF_RETURN_IF_ERROR(ctx->allocate_temp(ctx->expected_output_dtype(i),
+                                            tf_shape, &output_tensor));
+      ctx->set_output(i, unpad(output_tensor));
+      continue;
     }
-    ng_exec = it->second;
+
+    ConstantTensorBuffer* tf_buffer = new ConstantTensorBuffer(constant);
+    Tensor tf_tensor(ctx->expected_output_dtype(i), tf_shape, tf_buffer);
+    // The tensor holds its own reference to the buffer
+    tf_buffer->Unref();
+    ctx->set_output(i, unpad(tf_tensor));
   }
   return Status::OK();
 }
 
+Status NGraphEncapsulateOp::InstantiateFallback(OpKernelConstruction* ctx) {
+  // The function is added to a clone of the library, as the library of the
+  // session can not be modified. Functions instantiated this way are not
+  // rewritten by the bridge again.
+  string function_name = "ngraph_fallback_" + to_string(m_cluster_id);
+  FunctionDef fdef;
+  TF_RETURN_IF_ERROR(GraphToFunctionDef(m_graph, function_name, &fdef));
+  TF_RETURN_IF_ERROR(ctx->function_library()->Clone(
+      &m_fallback_flib_def, &m_fallback_pflr, &m_fallback_flr));
+  TF_RETURN_IF_ERROR(m_fallback_flib_def->AddFunctionDef(fdef));
+  return m_fallback_flr->Instantiate(function_name, AttrSlice(),
+                                     &m_fallback_handle);
+}
+
+void NGraphEncapsulateOp::RunFallback(OpKernelContext* ctx,
+                                      DoneCallback done) {
+  FunctionLibraryRuntime::Options opts;
+  opts.step_id = ctx->step_id();
+  opts.rendezvous = ctx->rendezvous();
+  opts.cancellation_manager = ctx->cancellation_manager();
+  opts.step_container = ctx->step_container();
+  opts.runner = ctx->runner();
+
+  std::vector<Tensor> args;
+  for (int i = 0; i < ctx->num_inputs(); i++) {
+    args.push_back(ctx->input(i));
+  }
+  auto rets = new std::vector<Tensor>;
+  m_fallback_flr->Run(opts, m_fallback_handle, args, rets,
+                      [ctx, rets, done](const Status& status) {
+                        if (status.ok()) {
+                          for (int i = 0; i < rets->size(); i++) {
+                            ctx->set_output(i, (*rets)[i]);
+                          }
+                        } else {
+                          ctx->SetStatus(status);
+                        }
+                        delete rets;
+                        done();
+                      });
+}
+
 }  // namespace ngraph_bridge
 
 REGISTER_KERNEL_BUILDER(Name("_nGraphEncapsulate").Device(DEVICE_CPU),
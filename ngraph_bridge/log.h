@@ -16,6 +16,7 @@
 
 #pragma once
 
+#include <atomic>
 #include <sstream>
 #include <string>
 #include "tensorflow/core/platform/default/logging.h"
@@ -26,30 +27,32 @@ namespace ngraph_bridge {
 
 class LogMessage : public tensorflow::internal::LogMessage {
  public:
+  // The level is read from NGRAPH_TF_VLOG_LEVEL once, and can be changed
+  // later through the API
   static tensorflow::int64 MinNGraphVLogLevel() {
-    const char* vlog_level = std::getenv("NGRAPH_TF_VLOG_LEVEL");
-    if (vlog_level == nullptr) {
-      return 0;
-    }
-
-    // Ideally we would use env_var / safe_strto64, but it is
-    // hard to use here without pulling in a lot of dependencies,
-    // so we use std:istringstream instead
-    std::string min_log_level(vlog_level);
-    std::istringstream ss(min_log_level);
-    tensorflow::int64 level;
-    if (!(ss >> level)) {
-      // Invalid vlog level setting, set level to default (0)
-      level = 0;
-    }
-    return level;
+    return s_min_vlog_level.load(std::memory_order_relaxed);
   }
+  static void SetMinNGraphVLogLevel(tensorflow::int64 level) {
+    s_min_vlog_level.store(level, std::memory_order_relaxed);
+  }
+
+ private:
+  static tensorflow::int64 ReadMinNGraphVLogLevel();
+  static std::atomic<tensorflow::int64> s_min_vlog_level;
 };
 
 }  // namespace ngraph_bridge
 }  // namespace tensorflow
 
+// Levels above NGRAPH_TF_MAX_VLOG_LEVEL, when the build defines it, are
+// compiled out along with the messages logged at them
+#ifdef NGRAPH_TF_MAX_VLOG_LEVEL
+#define NGRAPH_VLOG_IS_ON(lvl)          \
+  ((lvl) <= NGRAPH_TF_MAX_VLOG_LEVEL && \
+   (lvl) <= LogMessage::MinNGraphVLogLevel())
+#else
 #define NGRAPH_VLOG_IS_ON(lvl) ((lvl) <= LogMessage::MinNGraphVLogLevel())
+#endif
 
 #define NGRAPH_VLOG(lvl)      \
   if (NGRAPH_VLOG_IS_ON(lvl)) \
@@ -0,0 +1,85 @@
+/*******************************************************************************
+ * Copyright 2017-2020 Intel Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *******************************************************************************/
+
+#include <chrono>
+#include <cstdlib>
+#include <thread>
+
+#include "log.h"
+#include "memory_tracker.h"
+#include "utils.h"
+
+using namespace std;
+
+namespace tensorflow {
+namespace ngraph_bridge {
+
+// Static initializers
+MemoryTracker::Counters MemoryTracker::s_process;
+map<int, unique_ptr<MemoryTracker::Counters>> MemoryTracker::s_clusters;
+mutex MemoryTracker::s_clusters_mutex;
+atomic<int64> MemoryTracker::s_sampled_rss{0};
+once_flag MemoryTracker::s_sampling_started;
+
+void MemoryTracker::Add(Kind kind, int64 bytes, int cluster_id) {
+  s_process.bytes[kind] += bytes;
+  if (cluster_id >= 0) {
+    GetCounters(cluster_id)->bytes[kind] += bytes;
+  }
+}
+
+int64 MemoryTracker::Get(Kind kind, int cluster_id) {
+  if (cluster_id < 0) {
+    return s_process.bytes[kind];
+  }
+  return GetCounters(cluster_id)->bytes[kind];
+}
+
+void MemoryTracker::StartSampling() {
+  call_once(s_sampling_started, []() {
+    int interval_ms = 1000;
+    auto interval_env = utils::GetEnv("NGRAPH_TF_MEMORY_SAMPLE_INTERVAL_MS");
+    if (!interval_env.empty()) {
+      interval_ms = atoi(interval_env.c_str());
+    }
+    if (interval_ms <= 0) {
+      NGRAPH_VLOG(1) << "Memory sampling disabled";
+      return;
+    }
+
+    // The thread runs until the process exits
+    thread([interval_ms]() {
+      while (true) {
+        long vm, rss;
+        utils::MemoryProfile(vm, rss);
+        s_sampled_rss = static_cast<int64>(rss) * 1024;
+        this_thread::sleep_for(chrono::milliseconds(interval_ms));
+      }
+    }).detach();
+  });
+}
+
+MemoryTracker::Counters* MemoryTracker::GetCounters(int cluster_id) {
+  lock_guard<mutex> lock(s_clusters_mutex);
+  auto& counters = s_clusters[cluster_id];
+  if (counters == nullptr) {
+    counters.reset(new Counters());
+  }
+  return counters.get();
+}
+
+}  // namespace ngraph_bridge
+}  // namespace tensorflow
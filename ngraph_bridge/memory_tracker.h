@@ -0,0 +1,83 @@
+/*******************************************************************************
+ * Copyright 2017-2020 Intel Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *******************************************************************************/
+
+#pragma once
+
+#include <atomic>
+#include <map>
+#include <memory>
+#include <mutex>
+
+#include "tensorflow/core/platform/types.h"
+
+namespace tensorflow {
+namespace ngraph_bridge {
+
+// Accounts the memory owned by the bridge with atomic counters, process-wide
+// and per cluster, and keeps the resident set size of the process as last
+// sampled by a background thread. Reading the counters or the RSS never
+// makes a syscall, so it is cheap enough for every step.
+//
+// The sampling interval is set by NGRAPH_TF_MEMORY_SAMPLE_INTERVAL_MS
+// (default 1000), 0 disables sampling.
+class MemoryTracker {
+ public:
+  enum Kind {
+    // IE blobs allocated by the bridge, including hoisted params
+    kBlobs,
+    // Constants hoisted to parameters of cached executables. Weights shared
+    // between executables are only accounted process-wide.
+    kHoistedParams,
+    // Growth of the process while compiling the cached executables
+    kExecutables,
+    kNumKinds
+  };
+
+  // Adds bytes, negative when memory is released, to the process-wide
+  // counter of kind, and to the counter of cluster_id unless it is negative
+  static void Add(Kind kind, int64 bytes, int cluster_id = -1);
+  // Returns the bytes of kind, of the whole process if cluster_id is
+  // negative
+  static int64 Get(Kind kind, int cluster_id = -1);
+
+  // Starts the sampling thread unless it is running or disabled
+  static void StartSampling();
+  // Returns the RSS in bytes as last sampled, or 0 before the first sample
+  static int64 GetSampledRSS() { return s_sampled_rss; }
+
+ private:
+  struct Counters {
+    std::atomic<int64> bytes[kNumKinds];
+    Counters() {
+      for (auto& b : bytes) {
+        b = 0;
+      }
+    }
+  };
+
+  // Returns the counters of cluster_id, creating them on first use. They are
+  // never destroyed, so the pointer stays valid.
+  static Counters* GetCounters(int cluster_id);
+
+  static Counters s_process;
+  static std::map<int, std::unique_ptr<Counters>> s_clusters;
+  static std::mutex s_clusters_mutex;
+  static std::atomic<int64> s_sampled_rss;
+  static std::once_flag s_sampling_started;
+};
+
+}  // namespace ngraph_bridge
+}  // namespace tensorflow
@@ -0,0 +1,210 @@
+/*******************************************************************************
+ * Copyright 2017-2020 Intel Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *******************************************************************************/
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <thread>
+
+#include "log.h"
+#include "metrics.h"
+#include "utils.h"
+
+using namespace std;
+
+namespace tensorflow {
+namespace ngraph_bridge {
+
+// Static initializers
+const int64 MetricHistogram::kBucketBoundsUs[kNumBuckets - 1] = {
+    100,    250,    500,     1000,    2500,    5000,     10000,    25000,
+    50000,  100000, 250000,  500000,  1000000, 10000000, 100000000};
+map<string, Metrics::Family<MetricCounter>> Metrics::s_counters;
+map<string, Metrics::Family<MetricHistogram>> Metrics::s_histograms;
+mutex Metrics::s_mutex;
+once_flag Metrics::s_periodic_dump_started;
+
+namespace {
+
+string FormatSeconds(int64 us) {
+  ostringstream seconds;
+  seconds.precision(15);
+  seconds << us / 1e6;
+  return seconds.str();
+}
+
+// Formats the labels of a sample, with an optional extra label
+string Labels(const string& labels, const string& extra = "") {
+  if (labels.empty() && extra.empty()) {
+    return "";
+  }
+  if (labels.empty() || extra.empty()) {
+    return "{" + labels + extra + "}";
+  }
+  return "{" + labels + "," + extra + "}";
+}
+
+}  // namespace
+
+void MetricHistogram::Observe(int64 duration_us) {
+  int bucket = 0;
+  while (bucket < kNumBuckets - 1 && duration_us > kBucketBoundsUs[bucket]) {
+    bucket++;
+  }
+  m_counts[bucket].fetch_add(1, memory_order_relaxed);
+  m_sum_us.fetch_add(duration_us, memory_order_relaxed);
+}
+
+void MetricHistogram::Read(int64 counts[kNumBuckets], int64& sum_us) const {
+  for (int i = 0; i < kNumBuckets; i++) {
+    counts[i] = m_counts[i].load(memory_order_relaxed);
+  }
+  sum_us = m_sum_us.load(memory_order_relaxed);
+}
+
+ClusterMetrics ClusterMetrics::Get(int cluster_id) {
+  string labels = "cluster=\"" + to_string(cluster_id) + "\"";
+  ClusterMetrics metrics;
+  metrics.cache_hits = Metrics::GetCounter(
+      "ngraph_tf_cache_hits_total",
+      "Calls that found their executable in the cache", labels);
+  metrics.cache_misses = Metrics::GetCounter(
+      "ngraph_tf_cache_misses_total",
+      "Calls that did not find their executable in the cache", labels);
+  metrics.cache_evictions = Metrics::GetCounter(
+      "ngraph_tf_cache_evictions_total",
+      "Executables evicted from the cache", labels);
+  metrics.fallback_runs = Metrics::GetCounter(
+      "ngraph_tf_fallback_runs_total",
+      "Calls that ran the TF subgraph while the executable was compiled",
+      labels);
+  metrics.bytes_copied = Metrics::GetCounter(
+      "ngraph_tf_bytes_copied_total",
+      "Bytes of inputs copied to pad them to their batch bucket", labels);
+  metrics.compile_time = Metrics::GetHistogram(
+      "ngraph_tf_compile_seconds",
+      "Time to translate and compile an executable", labels);
+  metrics.execute_time = Metrics::GetHistogram(
+      "ngraph_tf_execute_seconds", "Time to execute a call", labels);
+  return metrics;
+}
+
+template <typename T>
+T* Metrics::GetMetric(map<string, Family<T>>& families, const string& name,
+                      const string& help, const string& labels) {
+  lock_guard<mutex> lock(s_mutex);
+  auto& family = families[name];
+  family.help = help;
+  auto& metric = family.metrics[labels];
+  if (metric == nullptr) {
+    metric.reset(new T());
+  }
+  return metric.get();
+}
+
+MetricCounter* Metrics::GetCounter(const string& name, const string& help,
+                                   const string& labels) {
+  return GetMetric(s_counters, name, help, labels);
+}
+
+MetricHistogram* Metrics::GetHistogram(const string& name, const string& help,
+                                       const string& labels) {
+  return GetMetric(s_histograms, name, help, labels);
+}
+
+string Metrics::Export() {
+  ostringstream text;
+  lock_guard<mutex> lock(s_mutex);
+  for (const auto& family : s_counters) {
+    text << "# HELP " << family.first << " " << family.second.help << "\n";
+    text << "# TYPE " << family.first << " counter\n";
+    for (const auto& it : family.second.metrics) {
+      text << family.first << Labels(it.first) << " " << it.second->Value()
+           << "\n";
+    }
+  }
+  for (const auto& family : s_histograms) {
+    text << "# HELP " << family.first << " " << family.second.help << "\n";
+    text << "# TYPE " << family.first << " histogram\n";
+    for (const auto& it : family.second.metrics) {
+      int64 counts[MetricHistogram::kNumBuckets];
+      int64 sum_us;
+      it.second->Read(counts, sum_us);
+      int64 cumulative = 0;
+      for (int i = 0; i < MetricHistogram::kNumBuckets; i++) {
+        cumulative += counts[i];
+        string le =
+            i < MetricHistogram::kNumBuckets - 1
+                ? FormatSeconds(MetricHistogram::kBucketBoundsUs[i])
+                : "+Inf";
+        text << family.first << "_bucket"
+             << Labels(it.first, "le=\"" + le + "\"") << " " << cumulative
+             << "\n";
+      }
+      text << family.first << "_sum" << Labels(it.first) << " "
+           << FormatSeconds(sum_us) << "\n";
+      text << family.first << "_count" << Labels(it.first) << " "
+           << cumulative << "\n";
+    }
+  }
+  return text.str();
+}
+
+bool Metrics::Dump(const string& path) {
+  string tmp_path = path + ".tmp";
+  {
+    ofstream file(tmp_path);
+    if (!file) {
+      return false;
+    }
+    file << Export();
+    if (!file) {
+      return false;
+    }
+  }
+  return rename(tmp_path.c_str(), path.c_str()) == 0;
+}
+
+void Metrics::StartPeriodicDump() {
+  call_once(s_periodic_dump_started, []() {
+    string path = utils::GetEnv("NGRAPH_TF_METRICS_FILE");
+    if (path.empty()) {
+      return;
+    }
+    int interval_s = 10;
+    auto interval_env = utils::GetEnv("NGRAPH_TF_METRICS_INTERVAL_S");
+    if (!interval_env.empty()) {
+      interval_s = max(atoi(interval_env.c_str()), 1);
+    }
+    NGRAPH_VLOG(1) << "Writing metrics to " << path << " every "
+                   << interval_s << " s";
+
+    // The thread runs until the process exits
+    thread([path, interval_s]() {
+      while (true) {
+        this_thread::sleep_for(chrono::seconds(interval_s));
+        if (!Dump(path)) {
+          NGRAPH_VLOG(0) << "Unable to write metrics to " << path;
+        }
+      }
+    }).detach();
+  });
+}
+
+}  // namespace ngraph_bridge
+}  // namespace tensorflow
@@ -0,0 +1,116 @@
+/*******************************************************************************
+ * Copyright 2017-2020 Intel Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *******************************************************************************/
+
+#pragma once
+
+#include <atomic>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+
+#include "tensorflow/core/platform/types.h"
+
+namespace tensorflow {
+namespace ngraph_bridge {
+
+class MetricCounter {
+ public:
+  void Increment(int64 by = 1) {
+    m_value.fetch_add(by, std::memory_order_relaxed);
+  }
+  int64 Value() const { return m_value.load(std::memory_order_relaxed); }
+
+ private:
+  std::atomic<int64> m_value{0};
+};
+
+// Counts durations into fixed buckets, from 100 us to 100 s
+class MetricHistogram {
+ public:
+  static const int kNumBuckets = 16;
+  // Upper bounds of the buckets in microseconds, the last bucket is unbounded
+  static const int64 kBucketBoundsUs[kNumBuckets - 1];
+
+  void Observe(int64 duration_us);
+  // Fills counts with the number of durations in each bucket, which are not
+  // cumulative
+  void Read(int64 counts[kNumBuckets], int64& sum_us) const;
+
+ private:
+  std::atomic<int64> m_counts[kNumBuckets] = {};
+  std::atomic<int64> m_sum_us{0};
+};
+
+// The metrics of one cluster. They are owned by the registry and never
+// destroyed, so they can be updated without a lookup or a lock.
+struct ClusterMetrics {
+  MetricCounter* cache_hits = nullptr;
+  MetricCounter* cache_misses = nullptr;
+  MetricCounter* cache_evictions = nullptr;
+  MetricCounter* fallback_runs = nullptr;
+  // Bytes of inputs copied to pad them to their batch bucket
+  MetricCounter* bytes_copied = nullptr;
+  MetricHistogram* compile_time = nullptr;
+  MetricHistogram* execute_time = nullptr;
+
+  static ClusterMetrics Get(int cluster_id);
+};
+
+// Process-wide registry of counters and latency histograms, exported in the
+// Prometheus text format. Metrics are looked up by name and labels once, and
+// updated through the returned pointer with atomic operations only.
+//
+// If NGRAPH_TF_METRICS_FILE is set, the metrics are written to that file
+// every NGRAPH_TF_METRICS_INTERVAL_S seconds (default 10).
+class Metrics {
+ public:
+  // Returns the metric with name and labels, e.g. cluster="3", creating it
+  // on first use
+  static MetricCounter* GetCounter(const std::string& name,
+                                   const std::string& help,
+                                   const std::string& labels);
+  static MetricHistogram* GetHistogram(const std::string& name,
+                                       const std::string& help,
+                                       const std::string& labels);
+
+  static std::string Export();
+  // Writes the export to path through a temporary file, so that readers
+  // never see a partial export. Returns false if it can't be written.
+  static bool Dump(const std::string& path);
+  // Starts the thread writing NGRAPH_TF_METRICS_FILE, if it is set
+  static void StartPeriodicDump();
+
+ private:
+  template <typename T>
+  struct Family {
+    std::string help;
+    std::map<std::string, std::unique_ptr<T>> metrics;
+  };
+
+  template <typename T>
+  static T* GetMetric(std::map<std::string, Family<T>>& families,
+                      const std::string& name, const std::string& help,
+                      const std::string& labels);
+
+  static std::map<std::string, Family<MetricCounter>> s_counters;
+  static std::map<std::string, Family<MetricHistogram>> s_histograms;
+  static std::mutex s_mutex;
+  static std::once_flag s_periodic_dump_started;
+};
+
+}  // namespace ngraph_bridge
+}  // namespace tensorflow
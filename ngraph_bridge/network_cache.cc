@@ -0,0 +1,337 @@
+/*******************************************************************************
+ * Copyright 2017-2020 Intel Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *******************************************************************************/
+
+#include <unistd.h>
+#include <utime.h>
+#include <algorithm>
+#include <atomic>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <unordered_map>
+#include <vector>
+
+#include <ie_version.hpp>
+#include "tensorflow/core/lib/hash/hash.h"
+#include "tensorflow/core/platform/env.h"
+
+#include "default_opset.h"
+#include "log.h"
+#include "network_cache.h"
+#include "utils.h"
+#include "version.h"
+
+using namespace std;
+
+namespace tensorflow {
+namespace ngraph_bridge {
+
+mutex NetworkCache::s_cache_mutex;
+
+namespace {
+
+// Folds the attributes of the visited node into a running hash
+class AttributeHasher : public ngraph::AttributeVisitor {
+ public:
+  explicit AttributeHasher(uint64* hash) : m_hash(hash) {}
+
+  // False once an attribute whose value can't be hashed was visited
+  bool IsValid() const { return m_valid; }
+
+  using ngraph::AttributeVisitor::on_adapter;
+
+  void on_adapter(const string& name,
+                  ngraph::ValueAccessor<void>& adapter) override {
+    // The value of attributes without a typed accessor is opaque, so two
+    // functions differing only in it would share a key
+    NGRAPH_VLOG(3) << "Network cache can't hash attribute " << name
+                   << " of type " << adapter.get_type_info().name;
+    m_valid = false;
+  }
+  void on_adapter(const string& name,
+                  ngraph::ValueAccessor<string>& adapter) override {
+    Combine(name);
+    Combine(adapter.get());
+  }
+  void on_adapter(const string& name,
+                  ngraph::ValueAccessor<bool>& adapter) override {
+    Combine(name);
+    CombineValue(adapter.get());
+  }
+  void on_adapter(const string& name,
+                  ngraph::ValueAccessor<int64_t>& adapter) override {
+    Combine(name);
+    CombineValue(adapter.get());
+  }
+  void on_adapter(const string& name,
+                  ngraph::ValueAccessor<double>& adapter) override {
+    Combine(name);
+    CombineValue(adapter.get());
+  }
+  void on_adapter(const string& name,
+                  ngraph::ValueAccessor<vector<int64_t>>& adapter) override {
+    Combine(name);
+    CombineVector(adapter.get());
+  }
+  void on_adapter(const string& name,
+                  ngraph::ValueAccessor<vector<uint64_t>>& adapter) override {
+    Combine(name);
+    CombineVector(adapter.get());
+  }
+  void on_adapter(const string& name,
+                  ngraph::ValueAccessor<vector<float>>& adapter) override {
+    Combine(name);
+    CombineVector(adapter.get());
+  }
+  void on_adapter(const string& name,
+                  ngraph::ValueAccessor<vector<string>>& adapter) override {
+    Combine(name);
+    for (const auto& s : adapter.get()) {
+      Combine(s);
+    }
+  }
+
+ private:
+  void Combine(const string& s) {
+    *m_hash = Hash64(s.data(), s.size(), *m_hash);
+  }
+  template <typename T>
+  void CombineValue(T value) {
+    *m_hash =
+        Hash64(reinterpret_cast<const char*>(&value), sizeof(T), *m_hash);
+  }
+  template <typename T>
+  void CombineVector(const vector<T>& values) {
+    *m_hash = Hash64(reinterpret_cast<const char*>(values.data()),
+                     values.size() * sizeof(T), *m_hash);
+  }
+
+  uint64* m_hash;
+  bool m_valid = true;
+};
+
+}  // namespace
+
+bool NetworkCache::IsEnabled() { return !GetCacheDir().empty(); }
+
+string NetworkCache::GetCacheDir() {
+  return utils::GetEnv("NGRAPH_TF_NETWORK_CACHE_DIR");
+}
+
+string NetworkCache::GetPath(uint64 key) {
+  std::ostringstream path;
+  path << GetCacheDir() << "/" << std::hex << std::setw(16)
+       << std::setfill('0') << key << ".blob";
+  return path.str();
+}
+
+bool NetworkCache::ComputeKey(const shared_ptr<ngraph::Function>& func,
+                              const string& device,
+                              const map<string, string>& config, uint64* key) {
+  uint64 hash = 0;
+  auto combine = [&hash](const string& s) {
+    hash = Hash64(s.data(), s.size(), hash);
+  };
+
+  // Networks compiled by other versions of the stack are never reused
+  combine(version());
+  combine(ngraph_version());
+  combine(InferenceEngine::GetInferenceEngineVersion()->buildNumber);
+
+  combine(device);
+  for (const auto& it : config) {
+    combine(it.first);
+    combine(it.second);
+  }
+
+  // Nodes are identified by their position in topological order, so that the
+  // key does not depend on the names nGraph generates for them
+  unordered_map<const ngraph::Node*, uint64> node_index;
+  AttributeHasher attribute_hasher(&hash);
+  for (const auto& node : func->get_ordered_ops()) {
+    uint64 index = node_index.size();
+    node_index[node.get()] = index;
+
+    const auto& type_info = node->get_type_info();
+    combine(type_info.name);
+    uint64 type_version = type_info.version;
+    hash = Hash64(reinterpret_cast<const char*>(&type_version),
+                  sizeof(type_version), hash);
+
+    for (const auto& input : node->input_values()) {
+      uint64 edge[2] = {node_index.at(input.get_node()), input.get_index()};
+      hash = Hash64(reinterpret_cast<const char*>(edge), sizeof(edge), hash);
+    }
+    for (const auto& output : node->outputs()) {
+      std::ostringstream shape;
+      shape << output.get_partial_shape();
+      combine(output.get_element_type().get_type_name());
+      combine(shape.str());
+    }
+
+    // The names of inputs and outputs are used to bind blobs, so they must
+    // match between the exported and the importing network
+    if (ngraph::op::is_parameter(node)) {
+      combine(node->get_friendly_name());
+    } else if (ngraph::op::is_output(node)) {
+      combine(node->input_value(0).get_node()->get_friendly_name());
+    }
+
+    // The type and shape of constants were hashed with their output, so only
+    // their data is left. Their attributes are not visited, as their value
+    // has no typed accessor.
+    if (ngraph::op::is_constant(node)) {
+      auto constant = ngraph::as_type_ptr<opset::Constant>(node);
+      hash = Hash64(static_cast<const char*>(constant->get_data_ptr()),
+                    ngraph::shape_size(constant->get_shape()) *
+                        constant->get_element_type().size(),
+                    hash);
+      continue;
+    }
+    node->visit_attributes(attribute_hasher);
+    if (!attribute_hasher.IsValid()) {
+      NGRAPH_VLOG(2) << "Not caching the network of " << func->get_name()
+                     << ", " << node->get_type_info().name << " node "
+                     << node->get_friendly_name() << " can't be hashed";
+      return false;
+    }
+  }
+  *key = hash;
+  return true;
+}
+
+bool NetworkCache::Import(uint64 key, InferenceEngine::Core& core,
+                          const string& device,
+                          const map<string, string>& config,
+                          InferenceEngine::ExecutableNetwork& exe_network) {
+  auto path = GetPath(key);
+  std::ifstream blob(path, std::ios::binary);
+  if (!blob.is_open()) {
+    NGRAPH_VLOG(2) << "Network cache miss: " << path;
+    return false;
+  }
+
+  try {
+    exe_network = core.ImportNetwork(blob, device, config);
+  } catch (const std::exception& e) {
+    NGRAPH_VLOG(1) << "Failed to import network from " << path << ": "
+                   << e.what();
+    blob.close();
+    Env::Default()->DeleteFile(path).IgnoreError();
+    return false;
+  }
+
+  // Mark the network as recently used
+  utime(path.c_str(), nullptr);
+  NGRAPH_VLOG(2) << "Network cache hit: " << path;
+  return true;
+}
+
+void NetworkCache::Export(uint64 key,
+                          InferenceEngine::ExecutableNetwork& exe_network) {
+  auto cache_dir = GetCacheDir();
+  auto status = Env::Default()->RecursivelyCreateDir(cache_dir);
+  if (!status.ok()) {
+    NGRAPH_VLOG(1) << "Unable to create network cache directory " << cache_dir
+                   << ": " << status.error_message();
+    return;
+  }
+
+  // Write into a temporary file first, so that other processes sharing the
+  // cache never import a partially written network. The counter keeps
+  // threads of this process exporting the same network apart.
+  static std::atomic<uint64> tmp_count{0};
+  auto path = GetPath(key);
+  auto tmp_path = path + "." + to_string(getpid()) + "." +
+                  to_string(tmp_count++) + ".tmp";
+  {
+    std::ofstream blob(tmp_path, std::ios::binary);
+    try {
+      exe_network.Export(blob);
+    } catch (const std::exception& e) {
+      NGRAPH_VLOG(1) << "Failed to export network to " << path << ": "
+                     << e.what();
+      blob.close();
+      Env::Default()->DeleteFile(tmp_path).IgnoreError();
+      return;
+    }
+  }
+  status = Env::Default()->RenameFile(tmp_path, path);
+  if (!status.ok()) {
+    NGRAPH_VLOG(1) << "Failed to store network in " << path << ": "
+                   << status.error_message();
+    Env::Default()->DeleteFile(tmp_path).IgnoreError();
+    return;
+  }
+  NGRAPH_VLOG(2) << "Stored network in cache: " << path;
+
+  lock_guard<mutex> lock(s_cache_mutex);
+  Evict(cache_dir);
+}
+
+void NetworkCache::Evict(const string& cache_dir) {
+  int64 max_size = 1024;
+  auto max_size_env = utils::GetEnv("NGRAPH_TF_NETWORK_CACHE_SIZE_MB");
+  if (!max_size_env.empty()) {
+    max_size = atol(max_size_env.c_str());
+  }
+  max_size *= 1024 * 1024;
+
+  vector<string> children;
+  if (!Env::Default()->GetChildren(cache_dir, &children).ok()) {
+    return;
+  }
+
+  struct Entry {
+    int64 mtime_nsec;
+    int64 size;
+    string path;
+  };
+  vector<Entry> entries;
+  int64 total_size = 0;
+  for (const auto& child : children) {
+    if (child.size() < 5 || child.substr(child.size() - 5) != ".blob") {
+      continue;
+    }
+    auto path = cache_dir + "/" + child;
+    FileStatistics stats;
+    if (!Env::Default()->Stat(path, &stats).ok()) {
+      continue;
+    }
+    entries.push_back({stats.mtime_nsec, stats.length, path});
+    total_size += stats.length;
+  }
+  if (total_size <= max_size) {
+    return;
+  }
+
+  // Evict the least recently used networks first
+  sort(entries.begin(), entries.end(), [](const Entry& a, const Entry& b) {
+    return a.mtime_nsec < b.mtime_nsec;
+  });
+  for (const auto& entry : entries) {
+    if (total_size <= max_size) {
+      break;
+    }
+    NGRAPH_VLOG(2) << "Evicting " << entry.path << " from network cache";
+    if (Env::Default()->DeleteFile(entry.path).ok()) {
+      total_size -= entry.size;
+    }
+  }
+}
+
+}  // namespace ngraph_bridge
+}  // namespace tensorflow
@@ -0,0 +1,73 @@
+/*******************************************************************************
+ * Copyright 2017-2020 Intel Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *******************************************************************************/
+
+// The network cache persists compiled Inference Engine networks on disk, so
+// that a new process can import them instead of compiling them again. It is
+// enabled by pointing NGRAPH_TF_NETWORK_CACHE_DIR at a writable directory.
+// NGRAPH_TF_NETWORK_CACHE_SIZE_MB bounds the size of that directory; the
+// least recently used networks are evicted first.
+
+#pragma once
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+
+#include <ie_core.hpp>
+#include "ngraph/ngraph.hpp"
+#include "tensorflow/core/platform/types.h"
+
+using namespace std;
+
+namespace tensorflow {
+namespace ngraph_bridge {
+
+class NetworkCache {
+ public:
+  // Returns true if a cache directory has been configured
+  static bool IsEnabled();
+
+  // Computes a key that identifies the network compiled from func for the
+  // given device and plugin configuration. The key is stable across processes
+  // and changes whenever the bridge, nGraph or Inference Engine versions do.
+  // Returns false if func has attributes whose values can't be hashed, in
+  // which case its network must not be cached.
+  static bool ComputeKey(const shared_ptr<ngraph::Function>& func,
+                         const string& device,
+                         const map<string, string>& config, uint64* key);
+
+  // Imports the network stored under key, if any. Returns false on a miss or
+  // if the stored network could not be imported.
+  static bool Import(uint64 key, InferenceEngine::Core& core,
+                     const string& device, const map<string, string>& config,
+                     InferenceEngine::ExecutableNetwork& exe_network);
+
+  // Stores exe_network under key, evicting older networks if the cache grows
+  // beyond its size limit. Failures are logged and otherwise ignored.
+  static void Export(uint64 key,
+                     InferenceEngine::ExecutableNetwork& exe_network);
+
+ private:
+  static string GetCacheDir();
+  static string GetPath(uint64 key);
+  static void Evict(const string& cache_dir);
+
+  static mutex s_cache_mutex;
+};
+
+}  // namespace ngraph_bridge
+}  // namespace tensorflow
@@ -24,6 +24,7 @@
 #include "ngraph/pass/constant_folding.hpp"
 #include "ngraph/pass/manager.hpp"
 #include "ngraph/pass/pass_config.hpp"
+#include "ngraph/runtime/shared_buffer.hpp"
 #include "ngraph/slice_plan.hpp"
 
 #include "api.h"
@@ -34,6 +35,7 @@
 #include "ngraph_conversions.h"
 #include "pass/transpose_sinking.h"
 #include "tf_utils.h"
+#include "tracer.h"
 #include "utils.h"
 
 using tensorflow::int32;
@@ -82,29 +84,31 @@ static Status CheckAxisDimInRange(std::vector<int64> axes, size_t rank) {
 //
 // Helper for storing ops in ng_op_map.
 // For most of the cases, op would have one output so
-// vector ng_op_map[op_name] would contain one element.
+// vector ng_op_map.outputs[op->id()] would contain one element.
 //
 // If storing more than one output_nodes, make sure it's in
 // the same order as tensorflow would do that.
 //
 // Parameters:
 //    Builder::OpMap& ng_op_map        - The TF-to-nGraph op map.
-//    std::string op_name              - Name of the op.
+//    const Node* op                   - TF op being translated.
 //
 //    ng::Output<ng::Node> output_node - ng::Node to store
 //
 
-static void SaveNgOp(Builder::OpMap& ng_op_map, const std::string& op_name,
+static void SaveNgOp(Builder::OpMap& ng_op_map, const Node* op,
                      ng::Output<ng::Node> output_node) {
-  // no need to try-catch, map[key] will create vector object
-  // if not exists
-  ng_op_map[op_name].push_back(output_node);
+  ng_op_map.outputs[op->id()].push_back(std::move(output_node));
 }
 
 void Builder::SetTracingInfo(const std::string& op_name,
                              const ng::Output<ng::Node> ng_node) {
   auto node = ng_node.get_node_shared_ptr();
-  node->set_friendly_name(op_name + "/" + node->get_name());
+  const auto& name = node->get_name();
+  std::string friendly_name;
+  friendly_name.reserve(op_name.size() + 1 + name.size());
+  friendly_name.append(op_name).append(1, '/').append(name);
+  node->set_friendly_name(friendly_name);
   node->add_provenance_tag(op_name);
   if (api::IsLoggingPlacement()) {
     cout << "TF_to_NG: " << op_name << " --> " << node << "\n";
@@ -157,30 +161,23 @@ static Status GetInputNode(const Builder::OpMap& ng_op_map, const Node* op,
                            size_t input_idx, ng::Output<ng::Node>& result) {
   // input op may have resulted in more than one ng::Node (eg. Split)
   // we need to look at Edge to check index of the input op
-  std::vector<const Edge*> edges;
-  TF_RETURN_IF_ERROR(op->input_edges(&edges));
-  size_t src_output_idx;
-  try {
-    src_output_idx = edges.at(input_idx)->src_output();
-  } catch (const out_of_range&) {
+  const auto& edges = ng_op_map.input_edges[op->id()];
+  if (input_idx >= edges.size() || edges[input_idx] == nullptr) {
     return Status(error::NOT_FOUND, "Edge not found");
   }
+  const Edge* edge = edges[input_idx];
+  size_t src_output_idx = edge->src_output();
 
-  Node* tf_input;
-  TF_RETURN_IF_ERROR(op->input_node(input_idx, &tf_input));
-  std::vector<ng::Output<ng::Node>> ng_op;
-  try {
-    ng_op = ng_op_map.at(tf_input->name());
-  } catch (const out_of_range&) {
+  const auto& ng_op = ng_op_map.outputs[edge->src()->id()];
+  if (ng_op.empty()) {
     return Status(error::NOT_FOUND,
-                  string("Ngraph op not found for ") + tf_input->name());
+                  string("Ngraph op not found for ") + edge->src()->name());
   }
-  try {
-    result = ng_op.at(src_output_idx);
-  } catch (const out_of_range&) {
+  if (src_output_idx >= ng_op.size()) {
     return Status(error::NOT_FOUND, string("Input node not found at index ") +
                                         to_string(src_output_idx));
   }
+  result = ng_op[src_output_idx];
   return Status::OK();
 }
 
@@ -354,141 +351,34 @@ static Status GetStaticInputNode(
   return Status::OK();
 }
 
-// Taken from: tensorflow/core/grappler/optimizers/arithmetic_optimizer.cc
-// Extract values from a Const op to `values`. Returns true if succeeds.
-//
-// Modified with an extra `VecT` parameter to handle the case where the type
-// in the vector does not match TensorFlow's notion of what the C++ type
-// should be (e.g. when T is `bool`, we actually need a vector of `char` for
-// compatibility with nGraph).
-template <typename T, typename VecT = T>
-static Status ValuesFromConstNode(const NodeDef& node,
-                                  TensorShapeProto* const_tensor_shape,
-                                  std::vector<VecT>* values) {
-  if (node.op() != "Const") {
-    return errors::InvalidArgument("Node not a Const");
-  }
-
-  if (node.attr().at("dtype").type() != DataTypeToEnum<T>::value) {
-    std::stringstream ss;
-    ss << "Invalid data type defined for Const. Defined: "
-       << node.attr().at("dtype").type();
-    return errors::InvalidArgument(ss.str());
-  }
-
-  // TensorProto represents the content of the tensor in either <type>_val or
-  // tensor_content.
-  const TensorProto& tensor = node.attr().at("value").tensor();
-  typename checkpoint::SaveTypeTraits<T>::RepeatedField* tensor_values =
-      checkpoint::MutableTensorProtoData<T>(const_cast<TensorProto*>(&tensor));
-
-  const TensorShapeProto& shape = tensor.tensor_shape();
-  *const_tensor_shape = shape;
-  if (!tensor_values->empty() && tensor.has_tensor_shape()) {
-    // When tensor_shape is set, theoretically the representation of the data
-    // could be compressed. So, before copying values to the returned vector,
-    // make sure no compression happens.
-    if (shape.dim_size() == 1 && shape.dim(0).size() == tensor_values->size()) {
-      values->insert(values->end(), tensor_values->begin(),
-                     tensor_values->end());
-      return Status::OK();
-    }
-  }
-
-  const auto tensor_content_size = tensor.tensor_content().size();
-  CHECK_EQ(0, tensor_content_size % sizeof(VecT))
-      << " tensor_content_size (" << tensor_content_size
-      << ") is not a multiple of " << sizeof(VecT);
-
-  // If tensor_content_size is zero, we'll have to take the values from
-  // int_val, float_val, etc.
-  if (tensor_content_size == 0) {
-    int64 n_elements = 1;
-    for (auto i = 0; i < shape.dim_size(); i++) {
-      if (shape.dim(i).size() < 0) {
-        return errors::InvalidArgument(
-            "Const node has empty tensor and an unknown dimension size");
-      }
-      n_elements *= shape.dim(i).size();
-    }
-    values->resize(n_elements);
-
-    auto val_lastsaved = (T)0;  // cast
-
-    for (auto i = 0; i < n_elements; i++) {
-      auto& tensor = node.attr().at("value").tensor();
-      auto dt = node.attr().at("dtype").type();
-      int64 val_size = 0;
-      auto val_i = (T)0;  // cast
-      switch (dt) {
-        // TODO(amprocte/NGRAPH-2502): there are more element types to support
-        // here
-        case DT_INT32:
-          val_size = tensor.int_val_size();
-          if (val_size > 0) val_i = tensor.int_val()[i];
-          break;
-        case DT_INT64:
-          val_size = tensor.int64_val_size();
-          if (val_size > 0) val_i = tensor.int64_val()[i];
-          break;
-        case DT_FLOAT:
-          val_size = tensor.float_val_size();
-          if (val_size > 0) val_i = tensor.float_val()[i];
-          break;
-        case DT_BOOL:
-          val_size = tensor.bool_val_size();
-          if (val_size > 0) val_i = tensor.bool_val()[i];
-          break;
-        case DT_DOUBLE:
-          val_size = tensor.double_val_size();
-          if (val_size > 0) val_i = tensor.double_val()[i];
-          break;
-        default:
-          NGRAPH_VLOG(0)
-              << "Const node has empty tensor and we don't know how to "
-                 "handle this element type";
-          NGRAPH_VLOG(0) << node.DebugString();
-          NGRAPH_VLOG(0) << shape.DebugString();
-          return errors::Unimplemented("Encountered unknown element type ",
-                                       DataType_Name(dt),
-                                       " on an empty tensor");
-      }
-      if (val_size == 0) {
-        return errors::InvalidArgument("Empty values vector");
-      } else if (i < val_size) {
-        (*values)[i] = val_i;
-        val_lastsaved = val_i;
-      } else {
-        (*values)[i] = val_lastsaved;
-      }
-    }
-  } else {
-    values->resize(tensor_content_size / sizeof(VecT));
-    port::CopyToArray(tensor.tensor_content(),
-                      reinterpret_cast<char*>(values->data()));
-  }
-
-  return Status::OK();
-}
-
 // Helper for Builder::TranslateGraph ("Const" op)
-template <typename T, typename VecT = T>
+//
+// The value of the Const is decoded once into a TF tensor, and the nGraph
+// Constant is built over the tensor's buffer, sharing its ownership, rather
+// than over a copy of it. The memory layouts of the TF types in
+// TF_NGRAPH_CONST_MAP match those of their nGraph element types.
+template <typename T>
 static Status MakeConstOp(const Node* op, ng::element::Type et,
                           ng::Output<ng::Node>& ng_node) {
-  vector<VecT> const_values;
-  TensorShapeProto shape_proto;
-
-  TF_RETURN_IF_ERROR(
-      ValuesFromConstNode<T, VecT>(op->def(), &shape_proto, &const_values));
-
-  TensorShape const_shape(shape_proto);
+  Tensor const_tensor;
+  if (!const_tensor.FromProto(op->def().attr().at("value").tensor())) {
+    return errors::InvalidArgument("Unable to parse the value of Const ",
+                                   op->name());
+  }
+  if (const_tensor.dtype() != DataTypeToEnum<T>::value) {
+    return errors::InvalidArgument(
+        "Invalid data type defined for Const. Defined: ",
+        DataType_Name(const_tensor.dtype()));
+  }
 
   ng::Shape ng_shape;
   TF_RETURN_IF_ERROR(
-      tf_utils::TFTensorShapeToNGraphShape(const_shape, &ng_shape));
+      tf_utils::TFTensorShapeToNGraphShape(const_tensor.shape(), &ng_shape));
 
-  ng_node =
-      ConstructNgNode<opset::Constant>(op->name(), et, ng_shape, const_values);
+  auto data = const_tensor.tensor_data();
+  auto buffer = make_shared<ng::runtime::SharedBuffer<Tensor>>(
+      const_cast<char*>(data.data()), data.size(), const_tensor);
+  ng_node = ConstructNgNode<opset::Constant>(op->name(), et, ng_shape, buffer);
   return Status::OK();
 }
 
@@ -505,8 +395,7 @@ const Builder::ConstMap& Builder::TF_NGRAPH_CONST_MAP() {
       {DataType::DT_INT64, make_pair(MakeConstOp<int64>, ng::element::i64)},
       {DataType::DT_UINT8, make_pair(MakeConstOp<uint8>, ng::element::u8)},
       {DataType::DT_UINT16, make_pair(MakeConstOp<uint16>, ng::element::u16)},
-      {DataType::DT_BOOL,
-       make_pair(MakeConstOp<bool, char>, ng::element::boolean)}};
+      {DataType::DT_BOOL, make_pair(MakeConstOp<bool>, ng::element::boolean)}};
   return the_map;
 }
 
@@ -543,7 +432,7 @@ static Status TranslateUnaryOp(
   if (ng_node != ng_input) {
     Builder::SetTracingInfo(op->name(), ng_node);
   }
-  SaveNgOp(ng_op_map, op->name(), ng_node);
+  SaveNgOp(ng_op_map, op, ng_node);
   return Status::OK();
 }
 
@@ -604,7 +493,7 @@ static Status TranslateBinaryOp(
   if (ng_node != ng_lhs && ng_node != ng_rhs) {
     Builder::SetTracingInfo(op->name(), ng_node);
   }
-  SaveNgOp(ng_op_map, op->name(), ng_node);
+  SaveNgOp(ng_op_map, op, ng_node);
   return Status::OK();
 }
 
@@ -644,7 +533,7 @@ static Status TranslateAddNOp(const Node* op, const std::vector<const Tensor*>&,
       });  // accumulation: start with
            // first element. default op is
            // addition
-  SaveNgOp(ng_op_map, op->name(), ng_addn);
+  SaveNgOp(ng_op_map, op, ng_addn);
   return Status::OK();
 }
 static Status TranslateArgMinMax(
@@ -692,7 +581,7 @@ static Status TranslateArgMinMax(
   auto reshaped_indices =
       ConstructNgNode<opset::Squeeze>(op->name(), ng_indices, axis_to_remove);
   Builder::SetTracingInfo(op->name(), reshaped_indices);
-  SaveNgOp(ng_op_map, op->name(), reshaped_indices);
+  SaveNgOp(ng_op_map, op, reshaped_indices);
   return Status::OK();
 }
 
@@ -765,7 +654,7 @@ static Status TranslateAvgPoolOp(const Node* op,
   NGRAPH_VLOG(3) << "avgpool outshape: {" << ng::join(ng_avgpool.get_shape())
                  << "}";
 
-  SaveNgOp(ng_op_map, op->name(), ng_avgpool);
+  SaveNgOp(ng_op_map, op, ng_avgpool);
   return Status::OK();
 }
 
@@ -815,7 +704,7 @@ static Status TranslateBiasAddOp(
   ng::Output<ng::Node> ng_add =
       ConstructNgNode<opset::Add>(op->name(), ng_input, ng_bias_reshaped);
 
-  SaveNgOp(ng_op_map, op->name(), ng_add);
+  SaveNgOp(ng_op_map, op, ng_add);
   return Status::OK();
 }
 
@@ -831,7 +720,7 @@ static Status TranslateCastOp(const Node* op, const std::vector<const Tensor*>&,
   TF_RETURN_IF_ERROR(tf_utils::TFDataTypeToNGraphElementType(dtype, &ng_et));
 
   try {
-    SaveNgOp(ng_op_map, op->name(),
+    SaveNgOp(ng_op_map, op,
              ConstructNgNode<opset::Convert>(op->name(), ng_input, ng_et));
   } catch (const std::out_of_range&) {
     return errors::Unimplemented("Failed to convert TF data type: ",
@@ -866,9 +755,8 @@ static Status TranslateConcatV2Op(
     ng_args.push_back(ng_arg);
   }
 
-  SaveNgOp(
-      ng_op_map, op->name(),
-      ConstructNgNode<opset::Concat>(op->name(), ng_args, size_t(concat_axis)));
+  SaveNgOp(ng_op_map, op, ConstructNgNode<opset::Concat>(
+                              op->name(), ng_args, size_t(concat_axis)));
   return Status::OK();
 }
 
@@ -898,7 +786,7 @@ static Status TranslateConstOp(const Node* op,
                                  DataType_Name(dtype));
   }
 
-  SaveNgOp(ng_op_map, op->name(), ng_node);
+  SaveNgOp(ng_op_map, op, ng_node);
   return Status::OK();
 }
 
@@ -970,7 +858,7 @@ static Status TranslateConv2DOp(const Node* op,
       ng_padding_above, ng_dilations);
 
   NCHWtoNHWC(op->name(), is_nhwc, ng_conv);
-  SaveNgOp(ng_op_map, op->name(), ng_conv);
+  SaveNgOp(ng_op_map, op, ng_conv);
   return Status::OK();
 }
 
@@ -1063,7 +951,7 @@ static Status TranslateConv2DBackpropInputOp(
       ng_padding_below, ng_padding_above, ng_dilations);
 
   NCHWtoNHWC(op->name(), is_nhwc, ng_data);
-  SaveNgOp(ng_op_map, op->name(), ng_data);
+  SaveNgOp(ng_op_map, op, ng_data);
   return Status::OK();
 }
 
@@ -1138,7 +1026,7 @@ static Status TranslateConv3DOp(const Node* op,
       ng_padding_above, ng_dilations);
 
   NCHWtoNHWC(op->name(), is_ndhwc, ng_conv);
-  SaveNgOp(ng_op_map, op->name(), ng_conv);
+  SaveNgOp(ng_op_map, op, ng_conv);
   return Status::OK();
 }
 
@@ -1151,7 +1039,7 @@ static Status TranslateCumsumOp(const Node* op,
   TF_RETURN_IF_ERROR(GetNodeAttr(op->attrs(), "exclusive", &exclusive));
   TF_RETURN_IF_ERROR(GetNodeAttr(op->attrs(), "reverse", &reverse));
 
-  SaveNgOp(ng_op_map, op->name(),
+  SaveNgOp(ng_op_map, op,
            ConstructNgNode<opset::CumSum>(op->name(), ng_x, ng_axis, exclusive,
                                           reverse));
   return Status::OK();
@@ -1182,7 +1070,7 @@ static Status TranslateDepthToSpaceOp(const Node* op,
   ng::Output<ng::Node> depth_to_space = ConstructNgNode<opset::DepthToSpace>(
       op->name(), ng_input, ng_mode, block_size);
   NCHWtoNHWC(op->name(), is_nhwc, depth_to_space);
-  SaveNgOp(ng_op_map, op->name(), depth_to_space);
+  SaveNgOp(ng_op_map, op, depth_to_space);
   return Status::OK();
 }
 
@@ -1258,7 +1146,7 @@ static Status TranslateDepthwiseConv2dNativeOp(
       ng_padding_above, ng_dilations);
 
   NCHWtoNHWC(op->name(), is_nhwc, ng_conv);
-  SaveNgOp(ng_op_map, op->name(), ng_conv);
+  SaveNgOp(ng_op_map, op, ng_conv);
   return Status::OK();
 }
 
@@ -1271,7 +1159,7 @@ static Status TranslateExpandDimsOp(
   TF_RETURN_IF_ERROR(GetStaticInputVector(op, 1, static_input_map, &dims));
   auto ng_dims = ConstructNgNode<opset::Constant>(
       op->name(), ng::element::i64, ngraph::Shape{dims.size()}, dims);
-  SaveNgOp(ng_op_map, op->name(),
+  SaveNgOp(ng_op_map, op,
            ConstructNgNode<opset::Unsqueeze>(op->name(), ng_input, ng_dims));
   return Status::OK();
 }
@@ -1281,7 +1169,7 @@ static Status TranslateFillOp(
     Builder::OpMap& ng_op_map) {
   ng::Output<ng::Node> ng_value, ng_dims;
   TF_RETURN_IF_ERROR(GetInputNodes(ng_op_map, op, ng_dims, ng_value));
-  SaveNgOp(ng_op_map, op->name(),
+  SaveNgOp(ng_op_map, op,
            ConstructNgNode<opset::Broadcast>(op->name(), ng_value, ng_dims));
   return Status::OK();
 }
@@ -1332,14 +1220,14 @@ static Status TranslateFusedBatchNormOp(
       op->name(), ng_input, ng_scale, ng_offset, ng_mean, ng_variance,
       tf_epsilon);
   NCHWtoNHWC(op->name(), is_nhwc, ng_batch_norm);
-  SaveNgOp(ng_op_map, op->name(), ng_batch_norm);
-  SaveNgOp(ng_op_map, op->name(), ng_mean);
-  SaveNgOp(ng_op_map, op->name(), ng_variance);
-  SaveNgOp(ng_op_map, op->name(), ng_mean);      // reserve_space_1
-  SaveNgOp(ng_op_map, op->name(), ng_variance);  // reserve_space_2
+  SaveNgOp(ng_op_map, op, ng_batch_norm);
+  SaveNgOp(ng_op_map, op, ng_mean);
+  SaveNgOp(ng_op_map, op, ng_variance);
+  SaveNgOp(ng_op_map, op, ng_mean);      // reserve_space_1
+  SaveNgOp(ng_op_map, op, ng_variance);  // reserve_space_2
   if (is_v3) {
     // FusedBatchNormV3 has 6 outputs
-    SaveNgOp(ng_op_map, op->name(), ng_mean);  // reserve_space_3
+    SaveNgOp(ng_op_map, op, ng_mean);  // reserve_space_3
   }
   return Status::OK();
 }
@@ -1375,13 +1263,12 @@ static Status TranslateFusedMatMulOp(const Node* op,
 
   auto ng_add = ConstructNgNode<opset::Add>(op->name(), ng_matmul, ng_bias);
   if (fused_ops.size() == 1) {  // Only fusing BiasAdd
-    SaveNgOp(ng_op_map, op->name(), ng_add);
+    SaveNgOp(ng_op_map, op, ng_add);
   } else if (fused_ops.size() == 2) {  // Also has activation
     if (fused_ops[1] == "Relu") {
-      SaveNgOp(ng_op_map, op->name(),
-               ConstructNgNode<opset::Relu>(op->name(), ng_add));
+      SaveNgOp(ng_op_map, op, ConstructNgNode<opset::Relu>(op->name(), ng_add));
     } else if (fused_ops[1] == "Relu6") {
-      SaveNgOp(ng_op_map, op->name(),
+      SaveNgOp(ng_op_map, op,
                ConstructNgNode<opset::Clamp>(op->name(), ng_add, 0, 6));
     } else {
       return errors::Internal(
@@ -1409,7 +1296,7 @@ static Status TranslateGatherOp(
   auto gather_op = ConstructNgNode<opset::Gather>(op->name(), ng_input,
                                                   ng_input_indices, ng_axis);
 
-  SaveNgOp(ng_op_map, op->name(), gather_op);
+  SaveNgOp(ng_op_map, op, gather_op);
   return Status::OK();
 }
 
@@ -1450,7 +1337,7 @@ static Status TranslateGatherV2Op(
   auto gather_op = ConstructNgNode<opset::Gather>(op->name(), ng_input,
                                                   ng_input_coords, ng_axis);
 
-  SaveNgOp(ng_op_map, op->name(), gather_op);
+  SaveNgOp(ng_op_map, op, gather_op);
   return Status::OK();
 }
 
@@ -1610,7 +1497,7 @@ static Status TranslateFusedConv2DOp(const Node* op,
   ng::Output<ng::Node> ng_input_add, ng_fused_op_1;
   if (fused_ops.size() == 1) {
     NCHWtoNHWC(op->name(), is_nhwc, ng_fused_op_0);
-    SaveNgOp(ng_op_map, op->name(), ng_fused_op_0);
+    SaveNgOp(ng_op_map, op, ng_fused_op_0);
     return Status::OK();
   } else {
     // Add or Relu or Relu6
@@ -1635,7 +1522,7 @@ static Status TranslateFusedConv2DOp(const Node* op,
   ng::Output<ng::Node> ng_fused_op_2;
   if (fused_ops.size() == 2) {
     NCHWtoNHWC(op->name(), is_nhwc, ng_fused_op_1);
-    SaveNgOp(ng_op_map, op->name(), ng_fused_op_1);
+    SaveNgOp(ng_op_map, op, ng_fused_op_1);
     return Status::OK();
   } else {
     if (fused_ops[2] == "Relu") {
@@ -1643,7 +1530,7 @@ static Status TranslateFusedConv2DOp(const Node* op,
       ng_fused_op_2 = ConstructNgNode<opset::Relu>(
           op->name() + "_FusedConv2D_Relu", ng_fused_op_1);
       NCHWtoNHWC(op->name(), is_nhwc, ng_fused_op_2);
-      SaveNgOp(ng_op_map, op->name(), ng_fused_op_2);
+      SaveNgOp(ng_op_map, op, ng_fused_op_2);
     }
   }
   return Status::OK();
@@ -1654,7 +1541,7 @@ static Status TranslateIdentityOp(const Node* op,
                                   Builder::OpMap& ng_op_map) {
   ng::Output<ng::Node> ng_arg;
   TF_RETURN_IF_ERROR(GetInputNodes(ng_op_map, op, ng_arg));
-  SaveNgOp(ng_op_map, op->name(), ng_arg);
+  SaveNgOp(ng_op_map, op, ng_arg);
   return Status::OK();
 }
 
@@ -1686,7 +1573,7 @@ static Status TranslateIsFiniteOp(
   auto is_finite = ConstructNgNode<opset::LogicalAnd>(
       op->name(), neq_inf_and_neq_neg_inf, eq_nan);
 
-  SaveNgOp(ng_op_map, op->name(), is_finite);
+  SaveNgOp(ng_op_map, op, is_finite);
   return Status::OK();
 }
 
@@ -1715,7 +1602,7 @@ static Status TranslateL2LossOp(const Node* op,
   auto ng_sum =
       ConstructNgNode<opset::ReduceSum>(op->name(), ng_pow, ng_reduction_axes);
   auto ng_l2loss = ConstructNgNode<opset::Divide>(op->name(), ng_sum, const_2);
-  SaveNgOp(ng_op_map, op->name(), ng_l2loss);
+  SaveNgOp(ng_op_map, op, ng_l2loss);
   return Status::OK();
 }
 
@@ -1761,7 +1648,7 @@ static Status TranslateLRNOp(const Node* op,
   auto ng_output = ConstructNgNode<opset::LRN>(op->name(), ng_inp, alpha, beta,
                                                bias, (size_t)size);
   NCHWtoNHWC(op->name(), true, ng_output);
-  SaveNgOp(ng_op_map, op->name(), ng_output);
+  SaveNgOp(ng_op_map, op, ng_output);
   return Status::OK();
 }
 
@@ -1775,7 +1662,7 @@ static Status TranslateLogSoftmaxOp(const Node* op,
   int64 axes = rank - 1;
 
   auto ng_output = ConstructNgNode<opset::LogSoftmax>(op->name(), ng_inp, axes);
-  SaveNgOp(ng_op_map, op->name(), ng_output);
+  SaveNgOp(ng_op_map, op, ng_output);
   return Status::OK();
 }
 
@@ -1792,7 +1679,7 @@ static Status TranslateMatMulOp(const Node* op,
   bool transpose_b = false;
   TF_RETURN_IF_ERROR(GetNodeAttr(op->attrs(), "transpose_b", &transpose_b));
 
-  SaveNgOp(ng_op_map, op->name(),
+  SaveNgOp(ng_op_map, op,
            ConstructNgNode<opset::MatMul>(op->name(), ng_lhs, ng_rhs,
                                           transpose_a, transpose_b));
   return Status::OK();
@@ -1853,7 +1740,7 @@ static Status TranslateMaxPoolOp(const Node* op,
   NGRAPH_VLOG(3) << "maxpool outshape: {" << ng::join(ng_maxpool.get_shape())
                  << "}";
 
-  SaveNgOp(ng_op_map, op->name(), ng_maxpool);
+  SaveNgOp(ng_op_map, op, ng_maxpool);
   return Status::OK();
 }
 
@@ -1908,7 +1795,7 @@ static Status TranslateNonMaxSuppressionV2Op(
       std::vector<int64_t>{0, 1});
 
   Builder::SetTracingInfo(op->name(), ng_nmsv_slice);
-  SaveNgOp(ng_op_map, op->name(), ng_nmsv_slice);
+  SaveNgOp(ng_op_map, op, ng_nmsv_slice);
   return Status::OK();
 }
 
@@ -1944,7 +1831,7 @@ static Status TranslateReduceOp(
   ng::Output<ng::Node> ng_node =
       create_ng_node(ng_input, ng_reduction_axes, tf_keep_dims);
 
-  SaveNgOp(ng_op_map, op->name(), ng_node);
+  SaveNgOp(ng_op_map, op, ng_node);
   return Status::OK();
 }
 
@@ -1993,7 +1880,7 @@ static Status TranslateOneHotOp(
 
   auto ng_onehot = ConstructNgNode<opset::OneHot>(
       op->name(), ng_features, const_depth, ng_on, ng_off, one_hot_axis);
-  SaveNgOp(ng_op_map, op->name(), ng_onehot);
+  SaveNgOp(ng_op_map, op, ng_onehot);
   return Status::OK();
 }
 
@@ -2018,7 +1905,7 @@ static Status TranslatePackOp(const Node* op, const std::vector<const Tensor*>&,
 
   // if inputs shape is (2, 3, 4), and axis is 1, then we want
   // to create output_shape (2, num_inputs, 3, 4)
-  SaveNgOp(ng_op_map, op->name(), ConstructNgNode<opset::Concat>(
+  SaveNgOp(ng_op_map, op, ConstructNgNode<opset::Concat>(
                                       op->name(), ng_concat_inputs, tf_axis));
   return Status::OK();
 }
@@ -2086,7 +1973,7 @@ static Status TranslatePadOp(const Node* op,
       ConstructNgNode<opset::Pad>(op->name(), ng_input, pads_begin_node,
                                   pads_end_node, pad_val_op, pad_mode);
 
-  SaveNgOp(ng_op_map, op->name(), result_pad_op);
+  SaveNgOp(ng_op_map, op, result_pad_op);
   return Status::OK();
 }
 
@@ -2112,7 +1999,7 @@ static Status TranslateRangeOp(
   auto ng_range = ConstructNgNode<opset::Range>(op->name(), start_node,
                                                 stop_node, step_node, out_type);
 
-  SaveNgOp(ng_op_map, op->name(), ng_range);
+  SaveNgOp(ng_op_map, op, ng_range);
   return Status::OK();
 }
 
@@ -2128,7 +2015,7 @@ static Status TranslateRankOp(const Node* op, const std::vector<const Tensor*>&,
       op->name(), ng::element::i32, ng::Shape(),
       std::vector<int>({input_rank}));
 
-  SaveNgOp(ng_op_map, op->name(), ng_rank);
+  SaveNgOp(ng_op_map, op, ng_rank);
   return Status::OK();
 }
 
@@ -2155,7 +2042,7 @@ static Status TranslateRelu6Op(const Node* op,
                                Builder::OpMap& ng_op_map) {
   ng::Output<ng::Node> ng_input;
   TF_RETURN_IF_ERROR(GetInputNodes(ng_op_map, op, ng_input));
-  SaveNgOp(ng_op_map, op->name(),
+  SaveNgOp(ng_op_map, op,
            ConstructNgNode<opset::Clamp>(op->name(), ng_input, 0, 6));
   return Status::OK();
 }
@@ -2175,7 +2062,7 @@ static Status TranslateReshapeOp(
 
   auto ng_shape = ConstructNgNode<opset::Constant>(
       op->name(), ng::element::i64, ng::Shape{shape.size()}, shape);
-  SaveNgOp(ng_op_map, op->name(), ConstructNgNode<opset::Reshape>(
+  SaveNgOp(ng_op_map, op, ConstructNgNode<opset::Reshape>(
                                       op->name(), ng_input, ng_shape, false));
   return Status::OK();
 }
@@ -2211,7 +2098,7 @@ static Status TranslateShapeOp(const Node* op,
   TF_RETURN_IF_ERROR(tf_utils::TFDataTypeToNGraphElementType(dtype, &type));
 
   // default output_type = element::i64
-  SaveNgOp(ng_op_map, op->name(),
+  SaveNgOp(ng_op_map, op,
            ConstructNgNode<opset::ShapeOf>(op->name(), ng_input, type));
   return Status::OK();
 }
@@ -2238,7 +2125,7 @@ static Status TranslateSizeOp(const Node* op, const std::vector<const Tensor*>&,
   auto ng_result = ConstructNgNode<opset::Constant>(
       op->name(), type, ng::Shape(0), std::vector<int64>({result}));
 
-  SaveNgOp(ng_op_map, op->name(), ng_result);
+  SaveNgOp(ng_op_map, op, ng_result);
   return Status::OK();
 }
 
@@ -2296,7 +2183,7 @@ static Status TranslateSliceOp(
   auto end = ConstructNgNode<opset::Constant>(
       op->name(), ng::element::i64, ng::Shape{end_vec.size()}, end_vec);
 
-  SaveNgOp(ng_op_map, op->name(),
+  SaveNgOp(ng_op_map, op,
            ConstructNgNode<opset::StridedSlice>(op->name(), ng_input, begin,
                                                 end, std::vector<int64_t>{},
                                                 std::vector<int64_t>{}));
@@ -2315,7 +2202,7 @@ static Status TranslateSoftmaxOp(const Node* op,
     return errors::InvalidArgument("TF Softmax logits must be >=1 dimension");
   }
 
-  SaveNgOp(ng_op_map, op->name(),
+  SaveNgOp(ng_op_map, op,
            ConstructNgNode<opset::Softmax>(op->name(), ng_input, rank - 1));
   return Status::OK();
 }
@@ -2345,7 +2232,7 @@ static Status TranslateSpaceToDepthOp(const Node* op,
   auto space_to_depth = ConstructNgNode<opset::SpaceToDepth>(
       op->name(), ng_input, ng_mode, block_size);
   NCHWtoNHWC(op->name(), is_nhwc, space_to_depth);
-  SaveNgOp(ng_op_map, op->name(), space_to_depth);
+  SaveNgOp(ng_op_map, op, space_to_depth);
   return Status::OK();
 }
 
@@ -2373,7 +2260,7 @@ static Status TranslateSplitOp(
   for (int i = 0; i < num_split; ++i) {
     auto out = ng_split->output(i);
     Builder::SetTracingInfo(op->name(), out);
-    SaveNgOp(ng_op_map, op->name(), out);
+    SaveNgOp(ng_op_map, op, out);
   }
   return Status::OK();
 }
@@ -2448,10 +2335,10 @@ static Status TranslateSplitVOp(
     for (size_t i = 0; i < split_lengths_vec.size(); ++i) {
       auto out = ng_split->output(i);
       Builder::SetTracingInfo(op->name(), out);
-      SaveNgOp(ng_op_map, op->name(), out);
+      SaveNgOp(ng_op_map, op, out);
     }
   } else {
-    SaveNgOp(ng_op_map, op->name(), ng_input);
+    SaveNgOp(ng_op_map, op, ng_input);
   }
 
   return Status::OK();
@@ -2484,7 +2371,7 @@ static Status TranslateSqueezeOp(const Node* op,
   auto ng_const = ConstructNgNode<opset::Constant>(
       op->name(), ng::element::i32, ng::Shape{tf_axis.size()}, tf_axis);
 
-  SaveNgOp(ng_op_map, op->name(),
+  SaveNgOp(ng_op_map, op,
            ConstructNgNode<opset::Squeeze>(op->name(), ng_input, ng_const));
   return Status::OK();
 }
@@ -2539,7 +2426,7 @@ static Status TranslateStridedSliceOp(
   };
 
   SaveNgOp(
-      ng_op_map, op->name(),
+      ng_op_map, op,
       ConstructNgNode<opset::StridedSlice>(
           op->name(), ng_input, begin, end, strides, mask_to_vec(begin_mask),
           mask_to_vec(end_mask), mask_to_vec(new_axis_mask),
@@ -2558,7 +2445,7 @@ static Status TranslateTileOp(
 
   auto ng_repeats = ConstructNgNode<opset::Constant>(
       op->name(), ng::element::i64, ng::Shape{multiples.size()}, multiples);
-  SaveNgOp(ng_op_map, op->name(),
+  SaveNgOp(ng_op_map, op,
            ConstructNgNode<opset::Tile>(op->name(), ng_input, ng_repeats));
   return Status::OK();
 }
@@ -2599,8 +2486,8 @@ static Status TranslateTopKV2Op(
   ng::Output<ng::Node> ng_indices = ng_result->output(1);
   Builder::SetTracingInfo(op->name(), ng_indices);
 
-  SaveNgOp(ng_op_map, op->name(), ng_values);
-  SaveNgOp(ng_op_map, op->name(), ng_indices);
+  SaveNgOp(ng_op_map, op, ng_values);
+  SaveNgOp(ng_op_map, op, ng_indices);
 
   return Status::OK();
 }
@@ -2610,7 +2497,7 @@ static Status TranslateTransposeOp(
     Builder::OpMap& ng_op_map) {
   ng::Output<ng::Node> ng_input, ng_permutation;
   TF_RETURN_IF_ERROR(GetInputNodes(ng_op_map, op, ng_input, ng_permutation));
-  SaveNgOp(ng_op_map, op->name(), ConstructNgNode<opset::Transpose>(
+  SaveNgOp(ng_op_map, op, ConstructNgNode<opset::Transpose>(
                                       op->name(), ng_input, ng_permutation));
   return Status::OK();
 }
@@ -2648,7 +2535,7 @@ static Status TranslateUnpackOp(const Node* op,
     auto slice = ConstructNgNode<opset::StridedSlice>(
         op->name(), ng_input, ng_begin, ng_end, begin_mask, end_mask,
         new_axis_mask, shrink_axis_mask);
-    SaveNgOp(ng_op_map, op->name(), slice);
+    SaveNgOp(ng_op_map, op, slice);
   }
   return Status::OK();
 }
@@ -2663,7 +2550,7 @@ static Status TranslateXdivyOp(
                                        ngraph::Shape{}, std::vector<int>({0}));
   auto x_is_zero = ConstructNgNode<opset::Equal>(op->name(), ng_x, zero);
   auto ng_xdivy = ConstructNgNode<opset::Divide>(op->name(), ng_x, ng_y);
-  SaveNgOp(ng_op_map, op->name(), ConstructNgNode<opset::Select>(
+  SaveNgOp(ng_op_map, op, ConstructNgNode<opset::Select>(
                                       op->name(), x_is_zero, ng_x, ng_xdivy));
   return Status::OK();
 }
@@ -2676,7 +2563,7 @@ static Status TranslateSelectOp(const Node* op,
       GetInputNodes(ng_op_map, op, ng_input1, ng_input2, ng_input3));
   auto ng_select = ConstructNgNode<opset::Select>(op->name(), ng_input1,
                                                   ng_input2, ng_input3);
-  SaveNgOp(ng_op_map, op->name(), ng_select);
+  SaveNgOp(ng_op_map, op, ng_select);
   return Status::OK();
 }
 
@@ -2689,7 +2576,7 @@ static Status TranslateWhereOp(
   auto transpose_order = ConstructNgNode<opset::Constant>(
       op->name(), ngraph::element::i64, ngraph::Shape{2},
       std::vector<int64_t>({1, 0}));
-  SaveNgOp(ng_op_map, op->name(), ConstructNgNode<opset::Transpose>(
+  SaveNgOp(ng_op_map, op, ConstructNgNode<opset::Transpose>(
                                       op->name(), non_zero, transpose_order));
   return Status::OK();
 }
@@ -2704,7 +2591,7 @@ static Status TranslateZerosLikeOp(const Node* op,
   std::vector<std::string> const_values(ng::shape_size(input_shape), "0");
   auto ng_result = ConstructNgNode<opset::Constant>(
       op->name(), ng_input.get_element_type(), input_shape, const_values);
-  SaveNgOp(ng_op_map, op->name(), ng_result);
+  SaveNgOp(ng_op_map, op, ng_result);
   return Status::OK();
 }
 
@@ -2840,6 +2727,21 @@ Status Builder::TranslateGraph(
     const std::vector<const Tensor*>& static_input_map,
     const Graph* input_graph, const string name,
     shared_ptr<ng::Function>& ng_function) {
+  std::vector<ng::PartialShape> ng_inputs;
+  for (const auto& input : inputs) {
+    ng::Shape ng_shape;
+    TF_RETURN_IF_ERROR(tf_utils::TFTensorShapeToNGraphShape(input, &ng_shape));
+    ng_inputs.push_back(ng_shape);
+  }
+  return TranslateGraph(ng_inputs, static_input_map, input_graph, name,
+                        ng_function);
+}
+
+Status Builder::TranslateGraph(
+    const std::vector<ng::PartialShape>& inputs,
+    const std::vector<const Tensor*>& static_input_map,
+    const Graph* input_graph, const string name,
+    shared_ptr<ng::Function>& ng_function) {
   //
   // We will visit ops in topological order.
   //
@@ -2876,10 +2778,24 @@ Status Builder::TranslateGraph(
   }
 
   //
-  // The op map holds a mapping from TensorFlow op names (strings) to
-  // vector of generated nGraph Output<Node>.
+  // The op map holds, for each TensorFlow node id, the vector of generated
+  // nGraph Output<Node>, and the data input edges of the node.
   //
   Builder::OpMap ng_op_map;
+  ng_op_map.outputs.resize(input_graph->num_node_ids());
+  ng_op_map.input_edges.resize(input_graph->num_node_ids());
+  for (const Edge* edge : input_graph->edges()) {
+    if (edge->IsControlEdge()) {
+      continue;
+    }
+    auto& edges = ng_op_map.input_edges[edge->dst()->id()];
+    if (edges.empty()) {
+      edges.resize(edge->dst()->num_inputs(), nullptr);
+    }
+    if (edge->dst_input() < edges.size()) {
+      edges[edge->dst_input()] = edge;
+    }
+  }
 
   //
   // Populate the parameter list, and also put parameters into the op map.
@@ -2899,15 +2815,11 @@ Status Builder::TranslateGraph(
     ng::element::Type ng_et;
     TF_RETURN_IF_ERROR(tf_utils::TFDataTypeToNGraphElementType(dtype, &ng_et));
 
-    ng::Shape ng_shape;
-    TF_RETURN_IF_ERROR(
-        tf_utils::TFTensorShapeToNGraphShape(inputs[index], &ng_shape));
-
     string prov_tag;
     GetNodeAttr(parm->attrs(), "_prov_tag", &prov_tag);
     auto ng_param =
-        ConstructNgNode<opset::Parameter>(prov_tag, ng_et, ng_shape);
-    SaveNgOp(ng_op_map, parm->name(), ng_param);
+        ConstructNgNode<opset::Parameter>(prov_tag, ng_et, inputs[index]);
+    SaveNgOp(ng_op_map, parm, ng_param);
     ng_parameter_list[index] =
         ngraph::as_type_ptr<opset::Parameter>(ng_param.get_node_shared_ptr());
   }
@@ -2979,14 +2891,17 @@ Status Builder::TranslateGraph(
   //
   // Apply additional passes on the nGraph function here.
   //
-  {
+  // Each pass runs on its own, so that it is traced separately
+  if (utils::GetEnv("NGRAPH_TF_CONSTANT_FOLDING") == "1") {
+    TraceSpan span("ConstantFolding");
     ngraph::pass::Manager passes;
-    if (utils::GetEnv("NGRAPH_TF_CONSTANT_FOLDING") == "1") {
-      passes.register_pass<ngraph::pass::ConstantFolding>();
-    }
-    if (utils::GetEnv("NGRAPH_TF_TRANSPOSE_SINKING") != "0") {
-      passes.register_pass<pass::TransposeSinking>();
-    }
+    passes.register_pass<ngraph::pass::ConstantFolding>();
+    passes.run_passes(ng_function);
+  }
+  if (utils::GetEnv("NGRAPH_TF_TRANSPOSE_SINKING") != "0") {
+    TraceSpan span("TransposeSinking");
+    ngraph::pass::Manager passes;
+    passes.register_pass<pass::TransposeSinking>();
     passes.run_passes(ng_function);
   }
   NGRAPH_VLOG(5) << "Done with passes";
@@ -3000,5 +2915,52 @@ Status Builder::TranslateGraph(
   return Status::OK();
 }
 
+Status Builder::SpecializeFunction(
+    const shared_ptr<ng::Function>& symbolic_function,
+    const std::vector<TensorShape>& inputs,
+    shared_ptr<ng::Function>& ng_function) {
+  TraceSpan span("Specialize");
+  ng_function = ngraph::clone_function(*symbolic_function);
+  auto parameters = ng_function->get_parameters();
+  if (parameters.size() != inputs.size()) {
+    return errors::Internal("Function has ", parameters.size(),
+                            " parameters, but ", inputs.size(),
+                            " input shapes are given");
+  }
+  for (int i = 0; i < inputs.size(); i++) {
+    ng::Shape ng_shape;
+    TF_RETURN_IF_ERROR(
+        tf_utils::TFTensorShapeToNGraphShape(inputs[i], &ng_shape));
+    if (!parameters[i]->get_partial_shape().compatible(ng_shape)) {
+      return errors::InvalidArgument("Input ", i, " of shape ",
+                                     inputs[i].DebugString(),
+                                     " does not match parameter ",
+                                     parameters[i]->get_friendly_name());
+    }
+    parameters[i]->set_partial_shape(ng_shape);
+  }
+
+  try {
+    ng_function->validate_nodes_and_infer_types();
+    // Shapes computed from the input shapes only become static once folded
+    if (ng_function->is_dynamic()) {
+      ngraph::pass::Manager passes;
+      passes.register_pass<ngraph::pass::ConstantFolding>();
+      passes.run_passes(ng_function);
+    }
+  } catch (const std::exception& ex) {
+    return errors::Internal("Unable to specialize function: ", ex.what());
+  }
+  if (ng_function->is_dynamic()) {
+    return errors::Unimplemented(
+        "Function has dynamic shapes once specialized");
+  }
+
+  for (auto result : ng_function->get_results()) {
+    result->set_needs_default_layout(true);
+  }
+  return Status::OK();
+}
+
 }  // namespace ngraph_bridge
 }  // namespace tensorflow
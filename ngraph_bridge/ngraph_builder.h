@@ -33,9 +33,27 @@ class Builder {
       const std::vector<TensorShape>& inputs,
       const std::vector<const Tensor*>& static_input_map, const Graph* tf_graph,
       const string name, std::shared_ptr<ngraph::Function>& ng_function);
+  // Translates the graph with parameters of possibly dynamic shape. Fails if
+  // any op translation needs a static shape that is not known.
+  static Status TranslateGraph(
+      const std::vector<ngraph::PartialShape>& inputs,
+      const std::vector<const Tensor*>& static_input_map, const Graph* tf_graph,
+      const string name, std::shared_ptr<ngraph::Function>& ng_function);
+  // Clones a function translated with dynamic input shapes and revalidates
+  // it for the given shapes, instead of translating the graph again. Fails
+  // if some output shapes remain dynamic.
+  static Status SpecializeFunction(
+      const std::shared_ptr<ngraph::Function>& symbolic_function,
+      const std::vector<TensorShape>& inputs,
+      std::shared_ptr<ngraph::Function>& ng_function);
 
-  using OpMap = std::unordered_map<std::string,
-                                   std::vector<ngraph::Output<ngraph::Node>>>;
+  // The nGraph outputs translated for each TF node, and the data input
+  // edges of each node by input index, both indexed by Node::id(), so that
+  // looking up the inputs of a node does not hash its name
+  struct OpMap {
+    std::vector<std::vector<ngraph::Output<ngraph::Node>>> outputs;
+    std::vector<std::vector<const Edge*>> input_edges;
+  };
   using ConstMap = std::map<
       DataType,
       std::pair<std::function<Status(const Node*, ngraph::element::Type,
@@ -34,6 +34,7 @@
 #include "log.h"
 #include "ngraph_optimizer.h"
 #include "ngraph_rewrite_pass.h"
+#include "warmup.h"
 
 using namespace std;
 
@@ -178,6 +179,7 @@ Status NgraphOptimizer::Optimize(tensorflow::grappler::Cluster* cluster,
 
   NGraphRewritePass rwp;
   rwp.Rewrite(&graph, skip_these_nodes, m_config_map);
+  Precompiler::Schedule(graph);
 
   // Convert the graph back to Graphdef
   graph.ToGraphDef(output);
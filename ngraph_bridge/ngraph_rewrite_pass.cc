@@ -30,6 +30,7 @@
 #include "mark_for_clustering.h"
 #include "ngraph_rewrite_pass.h"
 #include "tf_utils.h"
+#include "warmup.h"
 
 using namespace std;
 
@@ -73,6 +74,7 @@ Status NGraphRewritePass::Rewrite(
                           (already_processed ? "graph is already preprocessed"
                                              : "ngraph is disabled");
     ClusterManager::EvictAllClusters();
+    Precompiler::ReleaseAll();
     return Status::OK();
   }
 
@@ -106,7 +108,9 @@ Status NGraphRewritePass::Run(const GraphOptimizationPassOptions& options) {
     NGRAPH_VLOG(0) << "NGraphRewritePass: options.graph == nullptr";
     return Status::OK();
   }
-  return Rewrite(options.graph->get());
+  TF_RETURN_IF_ERROR(Rewrite(options.graph->get()));
+  Precompiler::Schedule(*options.graph->get());
+  return Status::OK();
 }
 
 }  // namespace ngraph_bridge
@@ -0,0 +1,105 @@
+/*******************************************************************************
+ * Copyright 2017-2020 Intel Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *******************************************************************************/
+
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <vector>
+
+#include "perf_counters.h"
+#include "utils.h"
+
+using namespace std;
+
+namespace tensorflow {
+namespace ngraph_bridge {
+
+// Static initializers
+atomic<bool> PerfCounters::s_enabled{false};
+unordered_map<string, PerfCounters::Entry> PerfCounters::s_entries;
+mutex PerfCounters::s_entries_mutex;
+
+void PerfCounters::Enable() { s_enabled = true; }
+
+void PerfCounters::Disable() { s_enabled = false; }
+
+bool PerfCounters::IsEnabled() {
+  return s_enabled || utils::GetEnv("NGRAPH_TF_PERF_COUNTERS") == "1";
+}
+
+void PerfCounters::Record(
+    const map<string, InferenceEngine::InferenceEngineProfileInfo>& counters,
+    const unordered_map<string, string>& layer_tf_nodes) {
+  // A TF node is usually lowered to several layers, sum them up first so
+  // that each inference counts as a single call of the node
+  unordered_map<string, Entry> entries;
+  for (const auto& it : counters) {
+    if (it.second.status !=
+        InferenceEngine::InferenceEngineProfileInfo::EXECUTED) {
+      continue;
+    }
+    auto tf_node = layer_tf_nodes.find(it.first);
+    auto& entry = entries[tf_node == layer_tf_nodes.end() ? it.first
+                                                          : tf_node->second];
+    entry.real_time_us += it.second.realTime_uSec;
+    entry.cpu_time_us += it.second.cpu_uSec;
+  }
+
+  lock_guard<mutex> lock(s_entries_mutex);
+  for (const auto& it : entries) {
+    auto& entry = s_entries[it.first];
+    entry.real_time_us += it.second.real_time_us;
+    entry.cpu_time_us += it.second.cpu_time_us;
+    entry.calls++;
+  }
+}
+
+string PerfCounters::Report() {
+  vector<pair<string, Entry>> entries;
+  {
+    lock_guard<mutex> lock(s_entries_mutex);
+    entries.assign(s_entries.begin(), s_entries.end());
+  }
+  sort(entries.begin(), entries.end(),
+       [](const pair<string, Entry>& a, const pair<string, Entry>& b) {
+         return a.second.real_time_us > b.second.real_time_us;
+       });
+
+  ostringstream report;
+  report << "tf_node,calls,real_time_us,cpu_time_us\n";
+  for (const auto& it : entries) {
+    report << it.first << "," << it.second.calls << ","
+           << it.second.real_time_us << "," << it.second.cpu_time_us << "\n";
+  }
+  return report.str();
+}
+
+bool PerfCounters::Dump(const string& path) {
+  ofstream file(path);
+  if (!file) {
+    return false;
+  }
+  file << Report();
+  return bool(file);
+}
+
+void PerfCounters::Reset() {
+  lock_guard<mutex> lock(s_entries_mutex);
+  s_entries.clear();
+}
+
+}  // namespace ngraph_bridge
+}  // namespace tensorflow
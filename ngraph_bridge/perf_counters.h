@@ -0,0 +1,66 @@
+/*******************************************************************************
+ * Copyright 2017-2020 Intel Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *******************************************************************************/
+
+#pragma once
+
+#include <atomic>
+#include <map>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include <ie_core.hpp>
+
+namespace tensorflow {
+namespace ngraph_bridge {
+
+// Aggregates the per-layer execution times reported by Inference Engine by
+// the TF node each layer was translated from. Collection is enabled through
+// the API or by setting NGRAPH_TF_PERF_COUNTERS=1, and only applies to
+// executables compiled while it is enabled.
+class PerfCounters {
+ public:
+  static void Enable();
+  static void Disable();
+  static bool IsEnabled();
+
+  // Adds the counters of one inference. layer_tf_nodes maps IE layer names
+  // to the name of the TF node they originate from.
+  static void Record(
+      const std::map<std::string, InferenceEngine::InferenceEngineProfileInfo>&
+          counters,
+      const std::unordered_map<std::string, std::string>& layer_tf_nodes);
+
+  // Returns the aggregated counters as CSV, slowest TF node first
+  static std::string Report();
+  // Writes the report to path. Returns false if the file can't be written.
+  static bool Dump(const std::string& path);
+  static void Reset();
+
+ private:
+  struct Entry {
+    long long real_time_us = 0;
+    long long cpu_time_us = 0;
+    long long calls = 0;
+  };
+
+  static std::atomic<bool> s_enabled;
+  static std::unordered_map<std::string, Entry> s_entries;
+  static std::mutex s_entries_mutex;
+};
+
+}  // namespace ngraph_bridge
+}  // namespace tensorflow
@@ -0,0 +1,110 @@
+/*******************************************************************************
+ * Copyright 2017-2020 Intel Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *******************************************************************************/
+
+#include <cstdlib>
+#include <cstring>
+
+#include "tensorflow/core/lib/hash/hash.h"
+
+#include "ie_tensor.h"
+#include "log.h"
+#include "memory_tracker.h"
+#include "shared_weights.h"
+#include "utils.h"
+
+using namespace std;
+
+namespace tensorflow {
+namespace ngraph_bridge {
+
+struct SharedWeights::Weight {
+  shared_ptr<opset::Constant> constant;
+  shared_ptr<IETensor> tensor;
+
+  ~Weight() {
+    MemoryTracker::Add(MemoryTracker::kHoistedParams,
+                       -static_cast<int64>(tensor->get_size_in_bytes()));
+  }
+};
+
+// Static initializers
+mutex SharedWeights::s_mutex;
+unordered_multimap<uint64, weak_ptr<SharedWeights::Weight>>
+    SharedWeights::s_weights;
+
+bool SharedWeights::IsEnabled() {
+  static bool enabled = utils::GetEnv("NGRAPH_TF_SHARE_WEIGHTS") == "1";
+  return enabled;
+}
+
+bool SharedWeights::IsShareable(const opset::Constant& constant) {
+  static size_t min_bytes = []() -> size_t {
+    string min_kb_env = utils::GetEnv("NGRAPH_TF_SHARE_WEIGHTS_MIN_KB");
+    return (min_kb_env.empty() ? 64 : atol(min_kb_env.c_str())) * 1024;
+  }();
+  auto size = ngraph::shape_size(constant.get_shape()) *
+              constant.get_element_type().size();
+  return size > 0 && size >= min_bytes;
+}
+
+shared_ptr<ngraph::runtime::Tensor> SharedWeights::Get(
+    const shared_ptr<opset::Constant>& constant) {
+  const auto& element_type = constant->get_element_type();
+  const auto& shape = constant->get_shape();
+  auto data = constant->get_data_ptr();
+  size_t size = ngraph::shape_size(shape) * element_type.size();
+  uint64 hash = Hash64(static_cast<const char*>(data), size);
+
+  shared_ptr<Weight> weight;
+  {
+    lock_guard<mutex> lock(s_mutex);
+    auto range = s_weights.equal_range(hash);
+    for (auto it = range.first; it != range.second && weight == nullptr;
+         ++it) {
+      auto shared = it->second.lock();
+      if (shared != nullptr &&
+          shared->constant->get_element_type() == element_type &&
+          shared->constant->get_shape() == shape &&
+          memcmp(shared->constant->get_data_ptr(), data, size) == 0) {
+        weight = shared;
+      }
+    }
+
+    if (weight == nullptr) {
+      // Drop the weights no executable uses anymore
+      for (auto it = s_weights.begin(); it != s_weights.end();) {
+        if (it->second.expired()) {
+          it = s_weights.erase(it);
+        } else {
+          ++it;
+        }
+      }
+      weight = make_shared<Weight>();
+      weight->constant = constant;
+      weight->tensor = make_shared<IETensor>(element_type, shape,
+                                             const_cast<void*>(data));
+      MemoryTracker::Add(MemoryTracker::kHoistedParams, size);
+      s_weights.emplace(hash, weight);
+      NGRAPH_VLOG(2) << "Sharing weight " << constant->get_friendly_name()
+                     << " of " << size << " bytes";
+    }
+  }
+  // The tensor keeps the weight, and thus the constant, alive
+  return shared_ptr<ngraph::runtime::Tensor>(weight, weight->tensor.get());
+}
+
+}  // namespace ngraph_bridge
+}  // namespace tensorflow
@@ -0,0 +1,61 @@
+/*******************************************************************************
+ * Copyright 2017-2020 Intel Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *******************************************************************************/
+
+#pragma once
+
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+#include "tensorflow/core/platform/types.h"
+
+#include "ngraph/ngraph.hpp"
+
+#include "default_opset.h"
+
+namespace tensorflow {
+namespace ngraph_bridge {
+
+// Holds the weights that executables hoist from constants to parameters, so
+// that the executables specialized for different shapes of a cluster bind
+// one read-only blob per weight instead of each embedding a copy in its
+// network. Weights are identified by their type, shape and contents, and
+// live as long as an executable uses them.
+//
+// Sharing is enabled with NGRAPH_TF_SHARE_WEIGHTS=1, for constants of at
+// least NGRAPH_TF_SHARE_WEIGHTS_MIN_KB kilobytes (default 64). Plugins may
+// run layers with weights given as inputs slower, or not at all, in which
+// case executables embed their weights again.
+class SharedWeights {
+ public:
+  static bool IsEnabled();
+  // Returns whether constant is large enough to be shared
+  static bool IsShareable(const opset::Constant& constant);
+  // Returns a tensor over the data of constant, or over that of an identical
+  // constant that is already shared. The tensor keeps the constant alive.
+  static std::shared_ptr<ngraph::runtime::Tensor> Get(
+      const std::shared_ptr<opset::Constant>& constant);
+
+ private:
+  struct Weight;
+
+  static std::mutex s_mutex;
+  // Weights by hash of their contents
+  static std::unordered_multimap<uint64, std::weak_ptr<Weight>> s_weights;
+};
+
+}  // namespace ngraph_bridge
+}  // namespace tensorflow
@@ -0,0 +1,123 @@
+/*******************************************************************************
+ * Copyright 2017-2020 Intel Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *******************************************************************************/
+
+#include <unistd.h>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+
+#include "tracer.h"
+#include "utils.h"
+
+using namespace std;
+
+namespace tensorflow {
+namespace ngraph_bridge {
+
+// Static initializers
+atomic<bool> Tracer::s_enabled{utils::GetEnv("NGRAPH_TF_TRACE") == "1"};
+vector<Tracer::Event> Tracer::s_events;
+uint64 Tracer::s_num_recorded = 0;
+mutex Tracer::s_events_mutex;
+
+namespace {
+
+thread_local TraceContext t_context;
+
+// Small ids are easier to read in trace viewers than native thread ids
+int GetThreadId() {
+  static atomic<int> next_id{0};
+  thread_local int id = next_id++;
+  return id;
+}
+
+}  // namespace
+
+void Tracer::Enable() { s_enabled = true; }
+
+void Tracer::Disable() { s_enabled = false; }
+
+int64 Tracer::NowMicros() {
+  return chrono::duration_cast<chrono::microseconds>(
+             chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+void Tracer::Record(const char* name, int64 start_us, int64 end_us,
+                    const TraceContext& context) {
+  Event event{name, start_us, end_us - start_us, context, GetThreadId()};
+  lock_guard<mutex> lock(s_events_mutex);
+  if (s_events.empty()) {
+    int size = 100000;
+    auto size_env = utils::GetEnv("NGRAPH_TF_TRACE_BUFFER_SIZE");
+    if (!size_env.empty()) {
+      size = max(atoi(size_env.c_str()), 1);
+    }
+    s_events.resize(size);
+  }
+  s_events[s_num_recorded++ % s_events.size()] = event;
+}
+
+const TraceContext& Tracer::CurrentContext() { return t_context; }
+
+string Tracer::Flush() {
+  vector<Event> events;
+  {
+    lock_guard<mutex> lock(s_events_mutex);
+    // Oldest first
+    uint64 num_events = min<uint64>(s_num_recorded, s_events.size());
+    for (uint64 i = s_num_recorded - num_events; i < s_num_recorded; i++) {
+      events.push_back(s_events[i % s_events.size()]);
+    }
+    s_num_recorded = 0;
+  }
+
+  ostringstream json;
+  json << "{\"traceEvents\":[";
+  const char* separator = "\n";
+  for (const auto& event : events) {
+    json << separator << "{\"name\":\"" << event.name
+         << "\",\"ph\":\"X\",\"ts\":" << event.start_us
+         << ",\"dur\":" << event.duration_us << ",\"pid\":" << getpid()
+         << ",\"tid\":" << event.thread_id
+         << ",\"args\":{\"cluster_id\":" << event.context.cluster_id
+         << ",\"step_id\":" << event.context.step_id << "}}";
+    separator = ",\n";
+  }
+  json << "\n],\"displayTimeUnit\":\"ms\"}\n";
+  return json.str();
+}
+
+bool Tracer::Dump(const string& path) {
+  ofstream file(path);
+  if (!file) {
+    return false;
+  }
+  file << Flush();
+  return bool(file);
+}
+
+Tracer::ContextScope::ContextScope(int cluster_id, int64 step_id)
+    : m_previous(t_context) {
+  t_context.cluster_id = cluster_id;
+  t_context.step_id = step_id;
+}
+
+Tracer::ContextScope::~ContextScope() { t_context = m_previous; }
+
+}  // namespace ngraph_bridge
+}  // namespace tensorflow
@@ -0,0 +1,111 @@
+/*******************************************************************************
+ * Copyright 2017-2020 Intel Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *******************************************************************************/
+
+#pragma once
+
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "tensorflow/core/platform/types.h"
+
+namespace tensorflow {
+namespace ngraph_bridge {
+
+// The cluster and step that spans recorded on a thread are attributed to
+struct TraceContext {
+  int cluster_id = -1;
+  int64 step_id = -1;
+};
+
+// Records spans of the bridge's execution phases with microsecond resolution
+// into a ring buffer, and flushes them on demand as Chrome trace JSON, which
+// chrome://tracing and Perfetto load. Tracing is enabled through the API or
+// by setting NGRAPH_TF_TRACE=1. The buffer keeps the last
+// NGRAPH_TF_TRACE_BUFFER_SIZE spans (default 100000).
+class Tracer {
+ public:
+  static void Enable();
+  static void Disable();
+  static bool IsEnabled() { return s_enabled.load(std::memory_order_relaxed); }
+
+  static int64 NowMicros();
+  // Records a span of the current thread, attributed to context
+  static void Record(const char* name, int64 start_us, int64 end_us,
+                     const TraceContext& context);
+  // Records a span of the current thread, attributed to its current context
+  static void Record(const char* name, int64 start_us, int64 end_us) {
+    Record(name, start_us, end_us, CurrentContext());
+  }
+  static const TraceContext& CurrentContext();
+
+  // Returns the recorded spans as Chrome trace JSON and empties the buffer
+  static std::string Flush();
+  // Flushes the spans to path. Returns false if the file can't be written.
+  static bool Dump(const std::string& path);
+
+  // Sets the context of the current thread until destroyed
+  class ContextScope {
+   public:
+    ContextScope(int cluster_id, int64 step_id);
+    ~ContextScope();
+
+   private:
+    TraceContext m_previous;
+  };
+
+ private:
+  struct Event {
+    const char* name;
+    int64 start_us;
+    int64 duration_us;
+    TraceContext context;
+    int thread_id;
+  };
+
+  static std::atomic<bool> s_enabled;
+  static std::vector<Event> s_events;
+  // Number of spans recorded since the last flush, the oldest ones have been
+  // overwritten if it exceeds the size of s_events
+  static uint64 s_num_recorded;
+  static std::mutex s_events_mutex;
+};
+
+// Records a span from its construction to its destruction, if tracing is
+// enabled when it is constructed. name must outlive the tracer, e.g. be a
+// string literal.
+class TraceSpan {
+ public:
+  explicit TraceSpan(const char* name)
+      : m_name(name),
+        m_start_us(Tracer::IsEnabled() ? Tracer::NowMicros() : -1) {}
+  ~TraceSpan() {
+    if (m_start_us >= 0) {
+      Tracer::Record(m_name, m_start_us, Tracer::NowMicros());
+    }
+  }
+
+ private:
+  TraceSpan(const TraceSpan&) = delete;
+  TraceSpan& operator=(const TraceSpan&) = delete;
+
+  const char* m_name;
+  int64 m_start_us;
+};
+
+}  // namespace ngraph_bridge
+}  // namespace tensorflow
@@ -14,6 +14,8 @@
  * limitations under the License.
  *******************************************************************************/
 
+#include <fcntl.h>
+#include <cstdlib>
 #include <fstream>
 #include <iomanip>
 #include <iostream>
@@ -32,23 +34,29 @@ void MemoryProfile(long& vm_usage, long& resident_set) {
   vm_usage = 0;
   resident_set = 0;
 
-  // Get the two fields we want
-  long vsize;
-  long rss;
-
-  std::ifstream ifs("/proc/self/stat", std::ios_base::in);
-  std::string mem_in;
-  getline(ifs, mem_in);
-  if (mem_in != "") {
-    vector<string> mem_str = ngraph::split(mem_in, ' ');
-    vsize = std::stol(mem_str[22]);
-    rss = std::stol(mem_str[23]);
-
-    long page_size_kb = sysconf(_SC_PAGE_SIZE) /
-                        1024;  // in case x86-64 is configured to use 2MB pages
-    vm_usage = vsize / 1024;   // unit kb
-    resident_set = rss * page_size_kb;
+  // /proc/self/statm holds the sizes in pages, starting with the total
+  // program size and the resident set size. Unlike /proc/self/stat, it has
+  // no command name whose spaces would shift the fields, and it is read
+  // without allocating.
+  int fd = open("/proc/self/statm", O_RDONLY);
+  if (fd < 0) {
+    return;
   }
+  char buffer[128];
+  ssize_t len = read(fd, buffer, sizeof(buffer) - 1);
+  close(fd);
+  if (len <= 0) {
+    return;
+  }
+  buffer[len] = '\0';
+
+  char* end;
+  long vm_pages = strtol(buffer, &end, 10);
+  long rss_pages = strtol(end, nullptr, 10);
+  long page_size_kb = sysconf(_SC_PAGE_SIZE) /
+                      1024;  // in case x86-64 is configured to use 2MB pages
+  vm_usage = vm_pages * page_size_kb;  // unit kb
+  resident_set = rss_pages * page_size_kb;
 }
 
 void DumpNGGraph(std::shared_ptr<ngraph::Function> function,
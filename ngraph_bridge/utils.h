@@ -31,7 +31,8 @@ namespace tensorflow {
 namespace ngraph_bridge {
 namespace utils {
 
-// Collect the total memory usage through /proc/self/stat
+// Collect the virtual and resident memory of the process in KB through
+// /proc/self/statm. Makes syscalls, use MemoryTracker on hot paths.
 void MemoryProfile(long&, long&);
 
 // Check if we're supposed to dump graphs
@@ -0,0 +1,512 @@
+/*******************************************************************************
+ * Copyright 2017-2020 Intel Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *******************************************************************************/
+
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <sstream>
+
+#include "tensorflow/core/common_runtime/graph_constructor.h"
+#include "tensorflow/core/common_runtime/shape_refiner.h"
+#include "tensorflow/core/framework/node_def_util.h"
+#include "tensorflow/core/graph/algorithm.h"
+#include "tensorflow/core/platform/cpu_info.h"
+#include "tensorflow/core/platform/threadpool.h"
+
+#include "backend_manager.h"
+#include "cluster_manager.h"
+#include "executable_cache.h"
+#include "log.h"
+#include "ngraph_builder.h"
+#include "ngraph_rewrite_pass.h"
+#include "perf_counters.h"
+#include "timer.h"
+#include "tracer.h"
+#include "utils.h"
+#include "warmup.h"
+
+using namespace std;
+
+namespace tensorflow {
+namespace ngraph_bridge {
+
+namespace {
+
+// A translated cluster waiting to be compiled
+struct PendingCompile {
+  WarmupReport* report;
+  uint64 cluster_key;
+  string canonical_graph;
+  map<string, string> config;
+  // The backend the cluster key was computed for
+  shared_ptr<Backend> backend;
+  InputSignature signature;
+  shared_ptr<ngraph::Function> function;
+};
+
+// Returns the plugin configuration the encapsulate op of node passes to the
+// backend, i.e. its string attributes prefixed with _ngraph_
+map<string, string> GetDeviceConfig(const Node* node) {
+  map<string, string> config;
+  for (const auto& attr : node->attrs()) {
+    if (attr.first.find("_ngraph_") != string::npos &&
+        attr.second.value_case() == AttrValue::kS) {
+      config[attr.first.substr(strlen("_ngraph_"))] = attr.second.s();
+    }
+  }
+  return config;
+}
+
+// Returns the shapes of the inputs of node, or false if any is not fully
+// defined
+bool GetInputShapes(const Node* node, const ShapeRefiner& refiner,
+                    vector<TensorShape>& shapes) {
+  for (int i = 0; i < node->num_inputs(); i++) {
+    const Edge* edge;
+    if (!node->input_edge(i, &edge).ok()) {
+      return false;
+    }
+    auto context = refiner.GetContext(edge->src());
+    if (context == nullptr) {
+      return false;
+    }
+    auto handle = context->output(edge->src_output());
+    if (!context->FullyDefined(handle)) {
+      return false;
+    }
+    TensorShape shape;
+    for (int d = 0; d < context->Rank(handle); d++) {
+      shape.AddDim(context->Value(context->Dim(handle, d)));
+    }
+    shapes.push_back(shape);
+  }
+  return true;
+}
+
+// Translates the cluster of an encapsulate node for the shapes of its inputs,
+// and sets the shapes of its outputs in refiner for the nodes downstream.
+// Returns false if the cluster is skipped.
+bool TranslateCluster(Node* node, ShapeRefiner& refiner,
+                      PendingCompile& pending) {
+  auto& report = *pending.report;
+  if (!GetNodeAttr(node->attrs(), "ngraph_cluster", &report.cluster_id).ok()) {
+    report.status = "skipped: no cluster index";
+    return false;
+  }
+  vector<int32> static_inputs;
+  auto status =
+      GetNodeAttr(node->attrs(), "_ngraph_static_inputs", &static_inputs);
+  if (status.ok() && !static_inputs.empty()) {
+    report.status = "skipped: static inputs";
+    return false;
+  }
+  vector<TensorShape> input_shapes;
+  if (!GetInputShapes(node, refiner, input_shapes)) {
+    report.status = "skipped: unknown input shapes";
+    return false;
+  }
+
+  GraphDef* cluster_graph_def =
+      ClusterManager::GetClusterGraph(report.cluster_id);
+  if (cluster_graph_def == nullptr) {
+    report.status = "skipped: cluster graph not found";
+    return false;
+  }
+  GraphConstructorOptions opts;
+  opts.allow_internal_ops = true;
+  Graph cluster_graph(OpRegistry::Global());
+  status = ConvertGraphDefToGraph(opts, *cluster_graph_def, &cluster_graph);
+  if (status.ok()) {
+    Timer translate_time;
+    Tracer::ContextScope trace_context(report.cluster_id, -1);
+    TraceSpan span("Translate");
+    vector<const Tensor*> static_input_map(input_shapes.size(), nullptr);
+    try {
+      status = Builder::TranslateGraph(input_shapes, static_input_map,
+                                       &cluster_graph, report.name,
+                                       pending.function);
+    } catch (const std::exception& ex) {
+      status = errors::Internal(ex.what());
+    }
+    report.translate_time_ms = translate_time.ElapsedInMS();
+  }
+  if (!status.ok()) {
+    report.status = "failed: " + status.error_message();
+    return false;
+  }
+
+  pending.config = GetDeviceConfig(node);
+  try {
+    pending.backend = BackendManager::GetBackend();
+  } catch (const std::exception& ex) {
+    report.status = string("failed: ") + ex.what();
+    return false;
+  }
+  pending.cluster_key = ExecutableCache::ComputeClusterKey(
+      cluster_graph, pending.config, pending.backend->Name(),
+      pending.canonical_graph);
+  ExecutableCache::ComputeSignature(input_shapes, pending.signature);
+
+  auto context = refiner.GetContext(node);
+  const auto& results = pending.function->get_results();
+  for (int i = 0; i < results.size() && i < context->num_outputs(); i++) {
+    if (results[i]->get_output_partial_shape(0).is_dynamic()) {
+      continue;
+    }
+    vector<shape_inference::DimensionHandle> dims;
+    for (auto dim : results[i]->get_shape()) {
+      dims.push_back(context->MakeDim(static_cast<int64>(dim)));
+    }
+    refiner.SetShape(node, i, context->MakeShape(dims)).IgnoreError();
+  }
+  return true;
+}
+
+void Compile(PendingCompile& pending) {
+  auto& report = *pending.report;
+  Timer compile_time;
+
+  // Sessions or other warmups may be compiling the same cluster
+  lock_guard<mutex> lock(ExecutableCache::GetCompileMutex(pending.cluster_key));
+  if (ExecutableCache::Lookup(pending.cluster_key, pending.signature,
+                              /*count_miss=*/false) != nullptr) {
+    report.status = "cached";
+    return;
+  }
+
+  long vm, rss, vm0, rss0;
+  utils::MemoryProfile(vm0, rss0);
+  Tracer::ContextScope trace_context(report.cluster_id, -1);
+  shared_ptr<Executable> exec;
+  try {
+    TraceSpan span("Compile");
+    exec = pending.backend->Compile(pending.function, PerfCounters::IsEnabled(),
+                                   pending.config);
+  } catch (const std::exception& ex) {
+    report.status = string("failed: ") + ex.what();
+    return;
+  }
+  utils::MemoryProfile(vm, rss);
+  ExecutableCache::Insert(pending.cluster_key, std::move(pending.signature),
+                          exec, (rss - rss0) * 1024, report.cluster_id);
+  report.compile_time_ms = compile_time.ElapsedInMS();
+  report.status = "compiled";
+}
+
+// Translates the clusters of graph in topological order, so that the shapes
+// of their outputs propagate to the clusters downstream. Adds a report for
+// each cluster to reports, and hands each translated cluster to compile.
+// Pending compiles point into reports, which must not be modified until
+// they are done.
+Status TranslateClusters(
+    const Graph& graph, vector<WarmupReport>& reports,
+    const function<void(unique_ptr<PendingCompile>)>& compile) {
+  ShapeRefiner refiner(graph.versions(), graph.op_registry());
+  refiner.set_require_shape_inference_fns(false);
+  vector<Node*> order;
+  GetReversePostOrder(graph, &order);
+
+  int num_clusters = 0;
+  for (auto node : order) {
+    if (node->type_string() == "_nGraphEncapsulate") {
+      num_clusters++;
+    }
+  }
+  reports.clear();
+  reports.reserve(num_clusters);
+  for (auto node : order) {
+    TF_RETURN_IF_ERROR(refiner.AddNode(node));
+    if (node->type_string() != "_nGraphEncapsulate") {
+      continue;
+    }
+    reports.push_back(WarmupReport());
+    reports.back().name = node->name();
+    unique_ptr<PendingCompile> pending(new PendingCompile());
+    pending->report = &reports.back();
+    if (TranslateCluster(node, refiner, *pending)) {
+      compile(std::move(pending));
+    }
+  }
+  return Status::OK();
+}
+
+}  // namespace
+
+Status WarmupGraph(const GraphDef& graph_def,
+                   const map<string, TensorShape>& feed_shapes,
+                   vector<WarmupReport>& reports) {
+  GraphDef fed_graph_def = graph_def;
+  set<string> fed;
+  for (auto& node : *fed_graph_def.mutable_node()) {
+    auto it = feed_shapes.find(node.name());
+    if (it == feed_shapes.end()) {
+      continue;
+    }
+    if (node.op() != "Placeholder") {
+      return errors::InvalidArgument("Only placeholders can be fed, ",
+                                     node.name(), " is a ", node.op());
+    }
+    it->second.AsProto((*node.mutable_attr())["shape"].mutable_shape());
+    fed.insert(node.name());
+  }
+  for (const auto& it : feed_shapes) {
+    if (fed.count(it.first) == 0) {
+      return errors::InvalidArgument("Feed ", it.first,
+                                     " not found in the graph");
+    }
+  }
+
+  Graph graph(OpRegistry::Global());
+  GraphConstructorOptions opts;
+  TF_RETURN_IF_ERROR(ConvertGraphDefToGraph(opts, fed_graph_def, &graph));
+  NGraphRewritePass rewrite_pass;
+  TF_RETURN_IF_ERROR(rewrite_pass.Rewrite(&graph));
+
+  vector<unique_ptr<PendingCompile>> pending;
+  TF_RETURN_IF_ERROR(TranslateClusters(
+      graph, reports, [&pending](unique_ptr<PendingCompile> compile) {
+        pending.push_back(std::move(compile));
+      }));
+
+  NGRAPH_VLOG(1) << "Warmup compiling " << pending.size() << " of "
+                 << reports.size() << " clusters";
+  {
+    thread::ThreadPool pool(Env::Default(), "ngraph_warmup",
+                            port::MaxParallelism());
+    for (auto& compile : pending) {
+      PendingCompile* p = compile.get();
+      pool.Schedule([p]() { Compile(*p); });
+    }
+  }
+  for (const auto& report : reports) {
+    NGRAPH_VLOG(1) << "Warmup of cluster " << report.cluster_id << " ("
+                   << report.name << "): " << report.status << " in "
+                   << report.translate_time_ms + report.compile_time_ms
+                   << " ms";
+  }
+  return Status::OK();
+}
+
+string FormatWarmupReports(const vector<WarmupReport>& reports) {
+  std::ostringstream csv;
+  csv << "cluster,name,translate_time_ms,compile_time_ms,status\n";
+  for (const auto& report : reports) {
+    csv << report.cluster_id << "," << report.name << ","
+        << report.translate_time_ms << "," << report.compile_time_ms << ","
+        << report.status << "\n";
+  }
+  return csv.str();
+}
+
+// Static initializers
+std::mutex Precompiler::s_mutex;
+std::condition_variable Precompiler::s_done_cv;
+Precompiler::PrecompilationMap Precompiler::s_precompilations;
+
+thread::ThreadPool* Precompiler::GetPool() {
+  string env = utils::GetEnv("NGRAPH_TF_PRECOMPILE_THREADS");
+  int num_threads = atoi(env.c_str());
+  if (num_threads <= 0) {
+    return nullptr;
+  }
+  // Created the first time precompilation is enabled, and never destroyed
+  // as compilations may still be queued at exit
+  static mutex pool_mutex;
+  static thread::ThreadPool* pool = nullptr;
+  lock_guard<mutex> lock(pool_mutex);
+  if (pool == nullptr) {
+    pool = new thread::ThreadPool(Env::Default(), "ngraph_precompile",
+                                  num_threads);
+  }
+  return pool;
+}
+
+void Precompiler::Schedule(const Graph& graph) {
+  auto pool = GetPool();
+  if (pool == nullptr) {
+    return;
+  }
+  // Clusters of graphs seen before are already being precompiled
+  PrecompilationMap precompilations;
+  {
+    lock_guard<mutex> lock(s_mutex);
+    for (auto node : graph.op_nodes()) {
+      int cluster_id;
+      if (node->type_string() == "_nGraphEncapsulate" &&
+          GetNodeAttr(node->attrs(), "ngraph_cluster", &cluster_id).ok() &&
+          s_precompilations.count(cluster_id) == 0) {
+        auto precompilation = make_shared<Precompilation>();
+        precompilation->cluster_id = cluster_id;
+        s_precompilations[cluster_id] = precompilation;
+        precompilations[cluster_id] = precompilation;
+      }
+    }
+  }
+  if (precompilations.empty()) {
+    return;
+  }
+
+  // The rewrite pass goes on with the graph, translation works on a copy
+  auto graph_def = make_shared<GraphDef>();
+  graph.ToGraphDef(graph_def.get());
+  pool->Schedule([pool, graph_def, precompilations]() {
+    Translate(pool, *graph_def, precompilations);
+  });
+}
+
+void Precompiler::Translate(thread::ThreadPool* pool, const GraphDef& graph_def,
+                            const PrecompilationMap& precompilations) {
+  // Compiles hold on to the reports until the last of them is done
+  auto reports = make_shared<vector<WarmupReport>>();
+  set<int> scheduled;
+  Graph graph(OpRegistry::Global());
+  GraphConstructorOptions opts;
+  opts.allow_internal_ops = true;
+  auto status = ConvertGraphDefToGraph(opts, graph_def, &graph);
+  if (status.ok()) {
+    status = TranslateClusters(
+        graph, *reports,
+        [pool, reports, &precompilations,
+         &scheduled](unique_ptr<PendingCompile> pending) {
+          int cluster_id = pending->report->cluster_id;
+          auto it = precompilations.find(cluster_id);
+          if (it == precompilations.end() ||
+              !Acquire(*it->second, pending->cluster_key,
+                       pending->canonical_graph)) {
+            return;
+          }
+          scheduled.insert(cluster_id);
+          auto precompilation = it->second;
+          shared_ptr<PendingCompile> compile(std::move(pending));
+          pool->Schedule([reports, compile, precompilation]() {
+            Compile(*compile);
+            NGRAPH_VLOG(1) << "Precompile of cluster "
+                           << precompilation->cluster_id << ": "
+                           << compile->report->status;
+            Finish(precompilation);
+          });
+        });
+  }
+  if (!status.ok()) {
+    NGRAPH_VLOG(1) << "Precompile stopped: " << status.error_message();
+  }
+  for (const auto& report : *reports) {
+    if (precompilations.count(report.cluster_id) != 0 &&
+        scheduled.count(report.cluster_id) == 0) {
+      NGRAPH_VLOG(1) << "Precompile of cluster " << report.cluster_id << ": "
+                     << report.status;
+    }
+  }
+  for (const auto& it : precompilations) {
+    if (scheduled.count(it.first) == 0) {
+      Finish(it.second);
+    }
+  }
+}
+
+bool Precompiler::Acquire(Precompilation& precompilation, uint64& cluster_key,
+                          const string& canonical_graph) {
+  lock_guard<mutex> lock(s_mutex);
+  if (precompilation.dropped) {
+    return false;
+  }
+  ExecutableCache::AcquireCluster(cluster_key, canonical_graph);
+  precompilation.acquired = true;
+  precompilation.cluster_key = cluster_key;
+  return true;
+}
+
+void Precompiler::Finish(const shared_ptr<Precompilation>& precompilation) {
+  lock_guard<mutex> lock(s_mutex);
+  precompilation->done = true;
+  s_done_cv.notify_all();
+  if (precompilation->dropped || precompilation->claimed) {
+    Drop(*precompilation);
+    return;
+  }
+  if (!precompilation->acquired) {
+    return;
+  }
+
+  // Don't keep the executable forever for an op that may never be created
+  string env = utils::GetEnv("NGRAPH_TF_PRECOMPILE_TIMEOUT_S");
+  int64 timeout_s = env.empty() ? 60 : atol(env.c_str());
+  if (timeout_s > 0) {
+    Env::Default()->SchedClosureAfter(timeout_s * 1000000, [precompilation]() {
+      lock_guard<mutex> lock(s_mutex);
+      if (!precompilation->claimed && !precompilation->dropped) {
+        NGRAPH_VLOG(1) << "Precompile of cluster "
+                       << precompilation->cluster_id
+                       << " released, it was not claimed in time";
+        Drop(*precompilation);
+      }
+    });
+  }
+}
+
+void Precompiler::Claim(int cluster_id) {
+  lock_guard<mutex> lock(s_mutex);
+  auto it = s_precompilations.find(cluster_id);
+  if (it == s_precompilations.end()) {
+    return;
+  }
+  auto& precompilation = *it->second;
+  precompilation.claimed = true;
+  if (precompilation.done) {
+    Drop(precompilation);
+  }
+}
+
+void Precompiler::ReleaseAll() {
+  lock_guard<mutex> lock(s_mutex);
+  while (!s_precompilations.empty()) {
+    // Keeps the precompilation alive while it is removed from the map
+    auto precompilation = s_precompilations.begin()->second;
+    Drop(*precompilation);
+  }
+  s_done_cv.notify_all();
+}
+
+void Precompiler::Drop(Precompilation& precompilation) {
+  auto it = s_precompilations.find(precompilation.cluster_id);
+  if (it != s_precompilations.end() && it->second.get() == &precompilation) {
+    s_precompilations.erase(it);
+  }
+  precompilation.dropped = true;
+  if (precompilation.done) {
+    Release(precompilation);
+  }
+}
+
+void Precompiler::Release(Precompilation& precompilation) {
+  if (precompilation.acquired) {
+    ExecutableCache::ReleaseCluster(precompilation.cluster_key);
+    precompilation.acquired = false;
+  }
+}
+
+void Precompiler::Wait(int cluster_id) {
+  unique_lock<mutex> lock(s_mutex);
+  s_done_cv.wait(lock, [cluster_id] {
+    auto it = s_precompilations.find(cluster_id);
+    return it == s_precompilations.end() || it->second->done;
+  });
+}
+
+}  // namespace ngraph_bridge
+}  // namespace tensorflow
@@ -0,0 +1,120 @@
+/*******************************************************************************
+ * Copyright 2017-2020 Intel Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *******************************************************************************/
+
+#pragma once
+
+#include <condition_variable>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "tensorflow/core/framework/graph.pb.h"
+#include "tensorflow/core/framework/tensor_shape.h"
+#include "tensorflow/core/graph/graph.h"
+#include "tensorflow/core/lib/core/status.h"
+#include "tensorflow/core/platform/threadpool.h"
+
+namespace tensorflow {
+namespace ngraph_bridge {
+
+// Outcome of compiling one cluster ahead of time
+struct WarmupReport {
+  int cluster_id = -1;
+  string name;
+  int translate_time_ms = 0;
+  int compile_time_ms = 0;
+  // "compiled", "cached" if the executable was already cached, or the
+  // reason the cluster was skipped or failed to compile
+  string status;
+};
+
+// Rewrites a copy of graph_def the way sessions do, and compiles every
+// cluster for the shapes the fed placeholders propagate to it. Clusters are
+// compiled in parallel into the ExecutableCache, where encapsulate ops of
+// identical clusters created later by sessions find them. This requires the
+// session to see the same graph, e.g. with Grappler's rewrites disabled or
+// already applied to graph_def. Clusters with static inputs, or with inputs
+// of shapes unknown after propagation, are skipped.
+Status WarmupGraph(const GraphDef& graph_def,
+                   const std::map<string, TensorShape>& feed_shapes,
+                   std::vector<WarmupReport>& reports);
+
+// Formats reports as CSV, one line per cluster
+string FormatWarmupReports(const std::vector<WarmupReport>& reports);
+
+// Compiles the clusters of graphs as soon as they are rewritten, instead of
+// on the first run of each encapsulate op. Clusters are translated in
+// topological order with the shapes the placeholders of the graph propagate
+// to them, the same way as WarmupGraph, and compiled concurrently on a pool
+// of NGRAPH_TF_PRECOMPILE_THREADS threads (0 by default, which disables
+// precompilation). The executables are kept in the ExecutableCache until
+// the encapsulate op of their cluster claims them, for at most
+// NGRAPH_TF_PRECOMPILE_TIMEOUT_S seconds after they are compiled, or until
+// the cluster graphs are evicted.
+class Precompiler {
+ public:
+  // Starts compiling the clusters of a graph that has just been rewritten
+  static void Schedule(const Graph& graph);
+  // Called by the encapsulate op of cluster_id once it has acquired its
+  // cluster key, after which the precompiled executables are its own
+  static void Claim(int cluster_id);
+  // Blocks until the precompilation of cluster_id, if any, is done
+  static void Wait(int cluster_id);
+  // Forgets all precompilations, releasing the executables no encapsulate
+  // op has claimed. Called when the cluster graphs are evicted, as their
+  // indices are reused by the clusters created next.
+  static void ReleaseAll();
+
+ private:
+  struct Precompilation {
+    int cluster_id;
+    bool done = false;
+    bool claimed = false;
+    // Set once the precompilation is removed from s_precompilations, after
+    // which it releases its cluster key as soon as it is done
+    bool dropped = false;
+    // Cluster key acquired for the executable, if one is being compiled
+    bool acquired = false;
+    uint64 cluster_key = 0;
+  };
+  using PrecompilationMap = std::map<int, std::shared_ptr<Precompilation>>;
+
+  // Translates the clusters of graph_def and schedules the compilation of
+  // those in precompilations on pool
+  static void Translate(thread::ThreadPool* pool, const GraphDef& graph_def,
+                        const PrecompilationMap& precompilations);
+  // Keeps the executable of precompilation cached until it is claimed.
+  // Updates cluster_key as ExecutableCache::AcquireCluster does. Returns
+  // false if the precompilation was dropped in the meantime.
+  static bool Acquire(Precompilation& precompilation, uint64& cluster_key,
+                      const string& canonical_graph);
+  static void Finish(const std::shared_ptr<Precompilation>& precompilation);
+  // Removes precompilation from s_precompilations, and releases its cluster
+  // key once it is done
+  static void Drop(Precompilation& precompilation);
+  static void Release(Precompilation& precompilation);
+  // Returns the precompile pool, or nullptr if precompilation is disabled
+  static thread::ThreadPool* GetPool();
+
+  static std::mutex s_mutex;
+  static std::condition_variable s_done_cv;
+  static PrecompilationMap s_precompilations;
+};
+
+}  // namespace ngraph_bridge
+}  // namespace tensorflow
@@ -47,6 +47,13 @@ __all__ = [
     'is_logging_placement', '__version__', 'cxx11_abi_flag'
     'is_grappler_enabled', 'update_config',
     'set_disabled_ops', 'get_disabled_ops',
+    'enable_perf_counters', 'disable_perf_counters',
+    'is_perf_counters_enabled', 'get_perf_counters',
+    'dump_perf_counters', 'reset_perf_counters',
+    'get_executable_cache_stats', 'clear_executable_cache', 'warmup',
+    'get_memory_usage', 'set_vlog_level', 'get_vlog_level',
+    'enable_tracing', 'disable_tracing', 'is_tracing_enabled', 'get_trace',
+    'dump_trace', 'get_metrics', 'dump_metrics',
 ]
 
 ext = 'dylib' if system() == 'Darwin' else 'so'
@@ -126,6 +133,31 @@ if ngraph_classic_loaded:
     ngraph_bridge_lib.is_grappler_enabled.restype = ctypes.c_bool
     ngraph_bridge_lib.set_disabled_ops.argtypes = [ctypes.c_char_p]
     ngraph_bridge_lib.get_disabled_ops.restype = ctypes.c_char_p
+    ngraph_bridge_lib.is_perf_counters_enabled.restype = ctypes.c_bool
+    ngraph_bridge_lib.get_perf_counters.argtypes = [ctypes.POINTER(ctypes.c_char_p)]
+    ngraph_bridge_lib.get_perf_counters.restype = ctypes.c_bool
+    ngraph_bridge_lib.dump_perf_counters.argtypes = [ctypes.c_char_p]
+    ngraph_bridge_lib.dump_perf_counters.restype = ctypes.c_bool
+    ngraph_bridge_lib.is_tracing_enabled.restype = ctypes.c_bool
+    ngraph_bridge_lib.get_trace.argtypes = [ctypes.POINTER(ctypes.c_char_p)]
+    ngraph_bridge_lib.get_trace.restype = ctypes.c_bool
+    ngraph_bridge_lib.dump_trace.argtypes = [ctypes.c_char_p]
+    ngraph_bridge_lib.dump_trace.restype = ctypes.c_bool
+    ngraph_bridge_lib.get_metrics.argtypes = [ctypes.POINTER(ctypes.c_char_p)]
+    ngraph_bridge_lib.get_metrics.restype = ctypes.c_bool
+    ngraph_bridge_lib.dump_metrics.argtypes = [ctypes.c_char_p]
+    ngraph_bridge_lib.dump_metrics.restype = ctypes.c_bool
+    ngraph_bridge_lib.get_executable_cache_stats.argtypes = \
+        [ctypes.POINTER(ctypes.c_uint64)] * 5
+    ngraph_bridge_lib.warmup.argtypes = [
+        ctypes.c_char_p, ctypes.c_size_t, ctypes.c_char_p,
+        ctypes.POINTER(ctypes.c_char_p)
+    ]
+    ngraph_bridge_lib.warmup.restype = ctypes.c_bool
+    ngraph_bridge_lib.get_memory_usage.argtypes = \
+        [ctypes.c_int] + [ctypes.POINTER(ctypes.c_int64)] * 4
+    ngraph_bridge_lib.set_vlog_level.argtypes = [ctypes.c_int]
+    ngraph_bridge_lib.get_vlog_level.restype = ctypes.c_int
 
     def enable():
         ngraph_bridge_lib.enable()
@@ -168,6 +200,12 @@ if ngraph_classic_loaded:
     def is_logging_placement():
         return ngraph_bridge_lib.is_logging_placement()
 
+    def set_vlog_level(level):
+        ngraph_bridge_lib.set_vlog_level(level)
+
+    def get_vlog_level():
+        return ngraph_bridge_lib.get_vlog_level()
+
     def cxx11_abi_flag():
         return ngraph_bridge_lib.cxx11_abi_flag()
 
@@ -211,6 +249,99 @@ if ngraph_classic_loaded:
     def get_disabled_ops():
         return ngraph_bridge_lib.get_disabled_ops()
 
+    def enable_perf_counters():
+        ngraph_bridge_lib.enable_perf_counters()
+
+    def disable_perf_counters():
+        ngraph_bridge_lib.disable_perf_counters()
+
+    def is_perf_counters_enabled():
+        return ngraph_bridge_lib.is_perf_counters_enabled()
+
+    def get_perf_counters():
+        result = ctypes.c_char_p()
+        if not ngraph_bridge_lib.get_perf_counters(ctypes.byref(result)):
+            raise Exception("Cannot get performance counters")
+        return result.value.decode("utf-8")
+
+    def dump_perf_counters(path):
+        if not ngraph_bridge_lib.dump_perf_counters(path.encode("utf-8")):
+            raise Exception("Cannot write performance counters to " + path)
+
+    def reset_perf_counters():
+        ngraph_bridge_lib.reset_perf_counters()
+
+    def enable_tracing():
+        ngraph_bridge_lib.enable_tracing()
+
+    def disable_tracing():
+        ngraph_bridge_lib.disable_tracing()
+
+    def is_tracing_enabled():
+        return ngraph_bridge_lib.is_tracing_enabled()
+
+    def get_trace():
+        """Returns the spans traced since the last flush as Chrome trace JSON,
+        which chrome://tracing and Perfetto load"""
+        result = ctypes.c_char_p()
+        if not ngraph_bridge_lib.get_trace(ctypes.byref(result)):
+            raise Exception("Cannot get the trace")
+        return result.value.decode("utf-8")
+
+    def dump_trace(path):
+        if not ngraph_bridge_lib.dump_trace(path.encode("utf-8")):
+            raise Exception("Cannot write the trace to " + path)
+
+    def get_metrics():
+        """Returns the runtime metrics of the clusters in the Prometheus
+        text format"""
+        result = ctypes.c_char_p()
+        if not ngraph_bridge_lib.get_metrics(ctypes.byref(result)):
+            raise Exception("Cannot get the metrics")
+        return result.value.decode("utf-8")
+
+    def dump_metrics(path):
+        if not ngraph_bridge_lib.dump_metrics(path.encode("utf-8")):
+            raise Exception("Cannot write the metrics to " + path)
+
+    def get_executable_cache_stats():
+        names = ['hits', 'misses', 'evictions', 'entries', 'bytes']
+        values = [ctypes.c_uint64() for _ in names]
+        ngraph_bridge_lib.get_executable_cache_stats(
+            *[ctypes.byref(v) for v in values])
+        return {name: v.value for name, v in zip(names, values)}
+
+    def clear_executable_cache():
+        ngraph_bridge_lib.clear_executable_cache()
+
+    def get_memory_usage(cluster_id=-1):
+        """Returns the bytes of blobs, hoisted params and executables owned
+        by the bridge for cluster_id, or the whole process if it is negative,
+        and the RSS of the process as last sampled."""
+        names = ['blobs', 'hoisted_params', 'executables', 'rss']
+        values = [ctypes.c_int64() for _ in names]
+        ngraph_bridge_lib.get_memory_usage(cluster_id,
+                                           *[ctypes.byref(v) for v in values])
+        return {name: v.value for name, v in zip(names, values)}
+
+    def warmup(graph, feed_shapes):
+        """Compiles the clusters of graph (a tf.Graph or GraphDef) for the
+        shapes of its placeholders given in feed_shapes, a dict from
+        placeholder names to shapes. Returns a CSV report with the outcome
+        and compile time of every cluster."""
+        if hasattr(graph, 'as_graph_def'):
+            graph = graph.as_graph_def()
+        graph_def = graph.SerializeToString()
+        feeds = ';'.join(
+            name.split(':')[0] + ':' + ','.join(str(dim) for dim in shape)
+            for name, shape in feed_shapes.items())
+        result = ctypes.c_char_p()
+        if not ngraph_bridge_lib.warmup(graph_def, len(graph_def),
+                                        feeds.encode("utf-8"),
+                                        ctypes.byref(result)):
+            raise Exception("Warmup failed: " + result.value.decode("utf-8"))
+        return result.value.decode("utf-8")
+
     __version__ = \
     "nGraph bridge version: " + str(ngraph_bridge_lib.version()) + "\n" + \
     "nGraph version used for this build: " + str(ngraph_bridge_lib.ngraph_version()) + "\n" + \
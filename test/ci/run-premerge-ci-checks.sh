@@ -37,6 +37,8 @@ echo "--------------------------------------------------------------------------
 
 export GTEST_OUTPUT="xml:${BUILD_DIR}/xunit_gtest.xml"
 ./gtest_ngtf 
+export GTEST_OUTPUT="xml:${BUILD_DIR}/xunit_gtest_call_bindings.xml"
+./gtest_call_bindings
 
 pushd python
 # We need to explictly run python here, since "pytest" is also a shell script,
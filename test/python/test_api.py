@@ -19,7 +19,10 @@
 from __future__ import absolute_import
 
 import ctypes
+import json
+import numpy as np
 import pytest
+import tensorflow as tf
 
 from common import NgraphTest
 import ngraph_bridge
@@ -58,3 +61,100 @@ class TestNgraphAPI(NgraphTest):
     def test_stop_logging_placement(self):
         ngraph_bridge.stop_logging_placement()
         assert ngraph_bridge.is_logging_placement() == 0
+
+    def test_set_vlog_level(self):
+        level = ngraph_bridge.get_vlog_level()
+        ngraph_bridge.set_vlog_level(3)
+        assert ngraph_bridge.get_vlog_level() == 3
+        ngraph_bridge.set_vlog_level(level)
+        assert ngraph_bridge.get_vlog_level() == level
+
+    def test_enable_perf_counters(self):
+        ngraph_bridge.enable_perf_counters()
+        assert ngraph_bridge.is_perf_counters_enabled() == 1
+
+    def test_disable_perf_counters(self):
+        ngraph_bridge.disable_perf_counters()
+        assert ngraph_bridge.is_perf_counters_enabled() == 0
+
+    def test_reset_perf_counters(self):
+        ngraph_bridge.reset_perf_counters()
+        report = ngraph_bridge.get_perf_counters()
+        assert report.splitlines() == ["tf_node,calls,real_time_us,cpu_time_us"]
+
+    def test_enable_tracing(self):
+        ngraph_bridge.enable_tracing()
+        assert ngraph_bridge.is_tracing_enabled() == 1
+        ngraph_bridge.disable_tracing()
+        assert ngraph_bridge.is_tracing_enabled() == 0
+
+    def test_get_trace(self):
+        ngraph_bridge.get_trace()
+        trace = json.loads(ngraph_bridge.get_trace())
+        assert trace['traceEvents'] == []
+
+    def test_get_metrics(self):
+        for line in ngraph_bridge.get_metrics().splitlines():
+            assert line.startswith('# ') or line.startswith('ngraph_tf_')
+
+    def test_get_memory_usage(self):
+        usage = ngraph_bridge.get_memory_usage()
+        assert sorted(usage.keys()) == [
+            'blobs', 'executables', 'hoisted_params', 'rss'
+        ]
+        assert all(value >= 0 for value in usage.values())
+        cluster_usage = ngraph_bridge.get_memory_usage(12345)
+        assert cluster_usage['executables'] == 0
+        assert cluster_usage['hoisted_params'] == 0
+
+    def test_clear_executable_cache(self):
+        ngraph_bridge.clear_executable_cache()
+        stats = ngraph_bridge.get_executable_cache_stats()
+        assert sorted(stats.keys()) == [
+            'bytes', 'entries', 'evictions', 'hits', 'misses'
+        ]
+        assert stats['entries'] == 0
+        assert stats['bytes'] == 0
+
+    def test_warmup_unknown_feed(self):
+        graph = tf.Graph()
+        with graph.as_default():
+            x = tf.compat.v1.placeholder(
+                tf.float32, shape=(None, 3), name='x')
+            tf.abs(x)
+        with pytest.raises(Exception):
+            ngraph_bridge.warmup(graph, {'y': [2, 3]})
+
+    def test_warmup_report(self):
+        graph = tf.Graph()
+        with graph.as_default():
+            x = tf.compat.v1.placeholder(
+                tf.float32, shape=(None, 3), name='x')
+            y = tf.abs(x)
+
+        # Keep the single op cluster, as sessions of with_ngraph do
+        env_var_map = self.store_env_variables(
+            ["NGRAPH_TF_DISABLE_DEASSIGN_CLUSTERS"])
+        self.set_env_variable("NGRAPH_TF_DISABLE_DEASSIGN_CLUSTERS", "1")
+        ngraph_bridge.clear_executable_cache()
+        report = ngraph_bridge.warmup(graph, {'x:0': [2, 3]})
+        self.unset_env_variable("NGRAPH_TF_DISABLE_DEASSIGN_CLUSTERS")
+        self.restore_env_variables(env_var_map)
+
+        lines = report.splitlines()
+        assert lines[0] == \
+            "cluster,name,translate_time_ms,compile_time_ms,status"
+        assert len(lines) == 2
+        cluster, name, translate_time_ms, compile_time_ms, status = \
+            lines[1].split(',')
+        assert status == "compiled"
+        assert int(compile_time_ms) > 0
+
+        # Sessions running the same graph find the warmed up executable
+        stats = ngraph_bridge.get_executable_cache_stats()
+        with graph.as_default():
+            self.with_ngraph(
+                lambda sess: sess.run(y, feed_dict={x: np.ones((2, 3))}))
+        session_stats = ngraph_bridge.get_executable_cache_stats()
+        assert session_stats['hits'] > stats['hits']
+        assert session_stats['misses'] == stats['misses']
@@ -0,0 +1,68 @@
+# ==============================================================================
+#  Copyright 2018-2020 Intel Corporation
+#
+#  Licensed under the Apache License, Version 2.0 (the "License");
+#  you may not use this file except in compliance with the License.
+#  You may obtain a copy of the License at
+#
+#      http://www.apache.org/licenses/LICENSE-2.0
+#
+#  Unless required by applicable law or agreed to in writing, software
+#  distributed under the License is distributed on an "AS IS" BASIS,
+#  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+#  See the License for the specific language governing permissions and
+#  limitations under the License.
+# ==============================================================================
+"""nGraph TensorFlow bridge batch bucketing test
+
+"""
+from __future__ import absolute_import
+from __future__ import division
+from __future__ import print_function
+
+import numpy as np
+import pytest
+import tensorflow as tf
+tf.compat.v1.disable_eager_execution()
+
+from common import NgraphTest
+
+
+class TestBatchBuckets(NgraphTest):
+
+    def run_bucketed(self, async_execution):
+        env_var_map = self.store_env_variables(
+            ["NGRAPH_TF_BATCH_BUCKETS", "NGRAPH_TF_ASYNC_EXECUTION"])
+        self.set_env_variable("NGRAPH_TF_BATCH_BUCKETS", "pow2")
+        if async_execution:
+            self.set_env_variable("NGRAPH_TF_ASYNC_EXECUTION", "1")
+
+        x = tf.compat.v1.placeholder(tf.float32, shape=(None, 4))
+        w = tf.constant(np.random.rand(4, 5).astype(np.float32))
+        out = tf.nn.relu(tf.matmul(x, w) + 1.0)
+        # Batch sizes that are padded up to their bucket, run repeatedly so
+        # that inputs are allocated while earlier calls complete
+        inputs = [
+            np.random.rand(batch_size, 4).astype(np.float32)
+            for batch_size in [3, 5, 3, 7, 1, 6] * 4
+        ]
+
+        def run_test(sess):
+            return [sess.run(out, feed_dict={x: i}) for i in inputs]
+
+        try:
+            ng_results = self.with_ngraph(run_test)
+        finally:
+            self.unset_env_variable("NGRAPH_TF_BATCH_BUCKETS")
+            self.unset_env_variable("NGRAPH_TF_ASYNC_EXECUTION")
+            self.restore_env_variables(env_var_map)
+        tf_results = self.without_ngraph(run_test)
+        for ng_result, tf_result, i in zip(ng_results, tf_results, inputs):
+            assert ng_result.shape == (i.shape[0], 5)
+            assert np.allclose(ng_result, tf_result, rtol=1e-5, atol=1e-5)
+
+    def test_batch_buckets(self):
+        self.run_bucketed(async_execution=False)
+
+    def test_batch_buckets_async(self):
+        self.run_bucketed(async_execution=True)
@@ -71,3 +71,36 @@ class TestSetBackend(NgraphTest):
 
         # restore env_variables
         self.restore_env_variables(env_var_map)
+
+    def test_set_backend_between_sessions(self):
+        backends = ngraph_bridge.list_backends()
+        if len(backends) < 2:
+            pytest.skip("Needs two backends")
+        env_var_map = self.store_env_variables(["NGRAPH_TF_BACKEND"])
+        self.unset_env_variable("NGRAPH_TF_BACKEND")
+        previous_backend = ngraph_bridge.get_backend()
+
+        val = tf.compat.v1.placeholder(tf.float32, shape=(3,))
+        out = tf.abs(val)
+        feed_dict = {val: (1.4, -0.5, -1)}
+
+        # The first session stays open while the second runs the same graph,
+        # so that its executable is still cached
+        def run_on_second_backend(sess):
+            sess.run(out, feed_dict=feed_dict)
+            misses = ngraph_bridge.get_executable_cache_stats()['misses']
+            ngraph_bridge.set_backend(backends[1])
+            result = self.with_ngraph(
+                lambda sess2: sess2.run(out, feed_dict=feed_dict))
+            stats = ngraph_bridge.get_executable_cache_stats()
+            return result, stats['misses'] - misses
+
+        ngraph_bridge.set_backend(backends[0])
+        try:
+            result, new_misses = self.with_ngraph(run_on_second_backend)
+        finally:
+            ngraph_bridge.set_backend(previous_backend)
+            self.restore_env_variables(env_var_map)
+        # The executable compiled for the first backend is not reused
+        assert new_misses == 1
+        assert list(result) == pytest.approx([1.4, 0.5, 1])
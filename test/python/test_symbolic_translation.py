@@ -0,0 +1,69 @@
+# ==============================================================================
+#  Copyright 2018-2020 Intel Corporation
+#
+#  Licensed under the Apache License, Version 2.0 (the "License");
+#  you may not use this file except in compliance with the License.
+#  You may obtain a copy of the License at
+#
+#      http://www.apache.org/licenses/LICENSE-2.0
+#
+#  Unless required by applicable law or agreed to in writing, software
+#  distributed under the License is distributed on an "AS IS" BASIS,
+#  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+#  See the License for the specific language governing permissions and
+#  limitations under the License.
+# ==============================================================================
+"""nGraph TensorFlow bridge symbolic translation test
+
+"""
+from __future__ import absolute_import
+from __future__ import division
+from __future__ import print_function
+
+import numpy as np
+import pytest
+import tensorflow as tf
+tf.compat.v1.disable_eager_execution()
+
+from common import NgraphTest
+
+
+class TestSymbolicTranslation(NgraphTest):
+
+    def run_with_translation(self, symbolic):
+        env_var_map = self.store_env_variables(
+            ["NGRAPH_TF_SYMBOLIC_TRANSLATION"])
+        self.set_env_variable("NGRAPH_TF_SYMBOLIC_TRANSLATION",
+                              "1" if symbolic else "0")
+
+        # The reshape computes its target shape from the shape of the input,
+        # which only becomes static once specialized
+        x = tf.compat.v1.placeholder(tf.float32, shape=(None, None, 4))
+        w = tf.constant(np.random.rand(4, 3).astype(np.float32))
+        flat = tf.reshape(x, tf.stack([tf.shape(x)[0] * tf.shape(x)[1], 4]))
+        out = tf.nn.relu(tf.matmul(flat, w) - 0.5)
+        inputs = [
+            np.random.rand(*shape).astype(np.float32)
+            for shape in [(2, 3, 4), (5, 1, 4), (2, 3, 4), (1, 7, 4)]
+        ]
+
+        def run_test(sess):
+            return [sess.run(out, feed_dict={x: i}) for i in inputs]
+
+        try:
+            results = self.with_ngraph(run_test)
+        finally:
+            self.unset_env_variable("NGRAPH_TF_SYMBOLIC_TRANSLATION")
+            self.restore_env_variables(env_var_map)
+        return inputs, results, self.without_ngraph(run_test)
+
+    def test_symbolic_translation_matches_static(self):
+        np.random.seed(5)
+        inputs, static_results, tf_results = self.run_with_translation(False)
+        np.random.seed(5)
+        _, symbolic_results, _ = self.run_with_translation(True)
+        for i, static, symbolic, expected in zip(inputs, static_results,
+                                                 symbolic_results, tf_results):
+            assert static.shape == (i.shape[0] * i.shape[1], 3)
+            assert np.array_equal(static, symbolic)
+            assert np.allclose(static, expected, rtol=1e-5, atol=1e-5)
@@ -0,0 +1,186 @@
+/*******************************************************************************
+ * Copyright 2019-2020 Intel Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *******************************************************************************/
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+#include "gtest/gtest.h"
+
+#include <ie_core.hpp>
+#include "ngraph/ngraph.hpp"
+
+#include "ngraph_bridge/backend_manager.h"
+#include "ngraph_bridge/call_bindings.h"
+#include "ngraph_bridge/default_opset.h"
+#include "ngraph_bridge/executable_cache.h"
+#include "ngraph_bridge/ie_tensor.h"
+#include "test/test_utilities.h"
+
+using namespace std;
+namespace ng = ngraph;
+
+// Counts the allocations made through operator new by the thread that
+// enabled counting. The worker threads of the Inference Engine are not
+// counted. This replaces operator new for the whole binary, so these tests
+// are built separately from gtest_ngtf.
+static thread_local bool t_count_allocations = false;
+static std::atomic<int> g_allocations(0);
+
+void* operator new(size_t size) {
+  if (t_count_allocations) {
+    g_allocations++;
+  }
+  void* ptr = malloc(size == 0 ? 1 : size);
+  if (ptr == nullptr) {
+    throw std::bad_alloc();
+  }
+  return ptr;
+}
+
+void operator delete(void* ptr) noexcept { free(ptr); }
+
+namespace tensorflow {
+namespace ngraph_bridge {
+namespace testing {
+
+static shared_ptr<ng::Function> MakeAbsFunction() {
+  auto param = make_shared<opset::Parameter>(ng::element::f32, ng::Shape{2, 3});
+  auto abs = make_shared<opset::Abs>(param);
+  return make_shared<ng::Function>(abs, ng::ParameterVector{param});
+}
+
+// Runs a call that hits the executable cache the way the encapsulate op
+// does: computing the signature, looking up the executable, binding pooled
+// tensors to the inputs and outputs, calling it and releasing the bindings
+static void RunCacheHit(uint64 cluster_key, CallBindingsPool& pool,
+                        const vector<Tensor>& inputs, Tensor& output) {
+  static const vector<bool> input_is_static{false};
+  InputSignature signature;
+  ASSERT_OK(
+      ExecutableCache::ComputeSignature(inputs, input_is_static, signature));
+  auto exec = ExecutableCache::Lookup(cluster_key, signature);
+  ASSERT_NE(exec, nullptr);
+  auto bindings = pool.Acquire(exec, 1, 1);
+  ASSERT_OK(bindings->BindInput(0, ng::element::f32, inputs[0].shape(),
+                                inputs[0].data()));
+  ASSERT_OK(bindings->BindOutput(0, ng::element::f32, output.shape(),
+                                 output.data()));
+  ASSERT_TRUE(exec->Call(bindings->inputs, bindings->outputs));
+  pool.Release(move(bindings));
+}
+
+// A cache hit with the same shapes as a previous call, from the signature
+// to the release of the bindings, allocates nothing besides what the
+// Inference Engine allocates to set blobs and run inference. That part is
+// measured on an infer request of the same network outside of the bridge,
+// setting blobs over the same alternating memory.
+TEST(CallBindings, CacheHitDoesNotAllocate) {
+  auto backend = BackendManager::GetBackend();
+  ASSERT_NE(backend, nullptr);
+  auto exec = backend->Compile(MakeAbsFunction());
+  ASSERT_NE(exec, nullptr);
+
+  TensorShape shape({2, 3});
+  Tensor in1(DT_FLOAT, shape), in2(DT_FLOAT, shape);
+  Tensor out1(DT_FLOAT, shape), out2(DT_FLOAT, shape);
+  auto in1_data = in1.flat<float>(), in2_data = in2.flat<float>();
+  for (int i = 0; i < 6; i++) {
+    in1_data(i) = i % 2 ? i : -i;
+    in2_data(i) = i % 2 ? -i : i;
+  }
+  vector<Tensor> inputs1{in1}, inputs2{in2};
+
+  uint64 cluster_key = 0;
+  ExecutableCache::AcquireCluster(cluster_key, "CacheHitDoesNotAllocate");
+  InputSignature signature;
+  ExecutableCache::ComputeSignature({shape}, signature);
+  ExecutableCache::Insert(cluster_key, signature, exec, 0, -1);
+
+  // The first calls create the tensors and the infer request
+  CallBindingsPool pool(4);
+  RunCacheHit(cluster_key, pool, inputs1, out1);
+  RunCacheHit(cluster_key, pool, inputs2, out2);
+
+  g_allocations = 0;
+  t_count_allocations = true;
+  for (int i = 0; i < 4; i++) {
+    RunCacheHit(cluster_key, pool, i % 2 ? inputs2 : inputs1,
+                i % 2 ? out2 : out1);
+  }
+  t_count_allocations = false;
+  int hit_allocations = g_allocations;
+  ExecutableCache::ReleaseCluster(cluster_key);
+
+  for (int i = 0; i < 6; i++) {
+    EXPECT_EQ(out1.flat<float>()(i), i);
+    EXPECT_EQ(out2.flat<float>()(i), i);
+  }
+
+  // The same calls on an infer request of the same network
+  InferenceEngine::CNNNetwork network(MakeAbsFunction());
+  auto exe_network =
+      BackendManager::GetCore().LoadNetwork(network, backend->Name());
+  auto infer_req = exe_network.CreateInferRequest();
+  auto input_name = network.getInputsInfo().begin()->first;
+  auto output_name = network.getOutputsInfo().begin()->first;
+  IETensor ie_in1(ng::element::f32, ng::Shape{2, 3}, in1.data());
+  IETensor ie_in2(ng::element::f32, ng::Shape{2, 3}, in2.data());
+  IETensor ie_out1(ng::element::f32, ng::Shape{2, 3}, out1.data());
+  IETensor ie_out2(ng::element::f32, ng::Shape{2, 3}, out2.data());
+  auto infer = [&](int i) {
+    infer_req.SetBlob(input_name, (i % 2 ? ie_in2 : ie_in1).get_blob());
+    infer_req.SetBlob(output_name, (i % 2 ? ie_out2 : ie_out1).get_blob());
+    infer_req.Infer();
+  };
+  infer(0);
+  infer(1);
+
+  g_allocations = 0;
+  t_count_allocations = true;
+  for (int i = 0; i < 4; i++) {
+    infer(i);
+  }
+  t_count_allocations = false;
+  int ie_allocations = g_allocations;
+
+  EXPECT_LE(hit_allocations, ie_allocations);
+}
+
+// Zero-element tensors have no data to point at, their tensors own their
+// blob and are kept as they are by the next call
+TEST(CallBindings, ZeroElementTensors) {
+  CallBindings bindings;
+  bindings.inputs.resize(1);
+  TensorShape empty({0, 3});
+
+  ASSERT_OK(bindings.BindInput(0, ng::element::f32, empty, nullptr));
+  auto tensor = bindings.inputs[0];
+  ASSERT_NE(tensor, nullptr);
+  ASSERT_OK(bindings.BindInput(0, ng::element::f32, empty, nullptr));
+  EXPECT_EQ(bindings.inputs[0], tensor);
+
+  // Binding data of the same shape replaces the tensor
+  float data = 0;
+  ASSERT_OK(bindings.BindInput(0, ng::element::f32, empty, &data));
+  EXPECT_NE(bindings.inputs[0], tensor);
+  auto ie_tensor = static_pointer_cast<IETensor>(bindings.inputs[0]);
+  EXPECT_TRUE(ie_tensor->IsRebindable());
+}
+
+}  // namespace testing
+}  // namespace ngraph_bridge
+}  // namespace tensorflow
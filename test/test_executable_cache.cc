@@ -0,0 +1,113 @@
+/*******************************************************************************
+ * Copyright 2017-2020 Intel Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *******************************************************************************/
+
+#include "gtest/gtest.h"
+
+#include "tensorflow/core/graph/graph.h"
+#include "tensorflow/core/graph/node_builder.h"
+
+#include "ngraph_bridge/cluster_manager.h"
+#include "ngraph_bridge/executable_cache.h"
+#include "ngraph_bridge/warmup.h"
+#include "test/test_utilities.h"
+
+using namespace std;
+
+namespace tensorflow {
+namespace ngraph_bridge {
+namespace testing {
+
+// Builds the cluster graph of a single Abs op
+static void BuildAbsGraph(Graph& graph) {
+  Node* arg;
+  ASSERT_OK(NodeBuilder("arg", "_Arg")
+                .Attr("T", DT_FLOAT)
+                .Attr("index", 0)
+                .Finalize(&graph, &arg));
+  Node* abs;
+  ASSERT_OK(NodeBuilder("abs", "Abs")
+                .Input(arg, 0)
+                .Attr("T", DT_FLOAT)
+                .Finalize(&graph, &abs));
+  Node* retval;
+  ASSERT_OK(NodeBuilder("retval", "_Retval")
+                .Input(abs, 0)
+                .Attr("T", DT_FLOAT)
+                .Attr("index", 0)
+                .Finalize(&graph, &retval));
+}
+
+// Identical clusters share a key only when compiled for the same backend
+TEST(ExecutableCache, ClusterKeyIncludesDevice) {
+  Graph graph1(OpRegistry::Global());
+  BuildAbsGraph(graph1);
+  Graph graph2(OpRegistry::Global());
+  BuildAbsGraph(graph2);
+
+  map<string, string> config;
+  string canonical_cpu1, canonical_cpu2, canonical_gpu;
+  uint64 cpu1 =
+      ExecutableCache::ComputeClusterKey(graph1, config, "CPU", canonical_cpu1);
+  uint64 cpu2 =
+      ExecutableCache::ComputeClusterKey(graph2, config, "CPU", canonical_cpu2);
+  uint64 gpu =
+      ExecutableCache::ComputeClusterKey(graph2, config, "GPU", canonical_gpu);
+  EXPECT_EQ(cpu1, cpu2);
+  EXPECT_EQ(canonical_cpu1, canonical_cpu2);
+  EXPECT_NE(cpu1, gpu);
+  EXPECT_NE(canonical_cpu1, canonical_gpu);
+}
+
+// Precompiled executables no encapsulate op has claimed are released when
+// the cluster graphs are evicted
+TEST(Precompiler, ReleaseAllDropsUnclaimedExecutables) {
+  setenv("NGRAPH_TF_PRECOMPILE_THREADS", "1", true);
+  setenv("NGRAPH_TF_PRECOMPILE_TIMEOUT_S", "0", true);
+
+  Graph cluster_graph(OpRegistry::Global());
+  BuildAbsGraph(cluster_graph);
+  int cluster_id = ClusterManager::NewCluster();
+  cluster_graph.ToGraphDef(ClusterManager::GetClusterGraph(cluster_id));
+
+  Graph graph(OpRegistry::Global());
+  Node* input;
+  ASSERT_OK(NodeBuilder("input", "Placeholder")
+                .Attr("dtype", DT_FLOAT)
+                .Attr("shape", TensorShape({2, 3}))
+                .Finalize(&graph, &input));
+  Node* encap;
+  ASSERT_OK(NodeBuilder("encap", "_nGraphEncapsulate")
+                .Input(vector<NodeBuilder::NodeOut>{{input, 0}})
+                .Attr("Targuments", DataTypeVector{DT_FLOAT})
+                .Attr("Tresults", DataTypeVector{DT_FLOAT})
+                .Attr("ngraph_cluster", cluster_id)
+                .Attr("ngraph_graph_id", 0)
+                .Finalize(&graph, &encap));
+
+  uint64 entries = ExecutableCache::GetStats().entries;
+  Precompiler::Schedule(graph);
+  Precompiler::Wait(cluster_id);
+  EXPECT_EQ(ExecutableCache::GetStats().entries, entries + 1);
+  Precompiler::ReleaseAll();
+  EXPECT_EQ(ExecutableCache::GetStats().entries, entries);
+
+  unsetenv("NGRAPH_TF_PRECOMPILE_THREADS");
+  unsetenv("NGRAPH_TF_PRECOMPILE_TIMEOUT_S");
+}
+
+}  // namespace testing
+}  // namespace ngraph_bridge
+}  // namespace tensorflow
@@ -0,0 +1,71 @@
+/*******************************************************************************
+ * Copyright 2017-2020 Intel Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *******************************************************************************/
+
+
+#include "gtest/gtest.h"
+
+#include "ngraph_bridge/metrics.h"
+
+using namespace std;
+
+namespace tensorflow {
+namespace ngraph_bridge {
+namespace testing {
+
+TEST(Metrics, CountersAreSharedByNameAndLabels) {
+  auto counter = Metrics::GetCounter("test_counter_total", "Test counter",
+                                     "cluster=\"1\"");
+  EXPECT_EQ(counter, Metrics::GetCounter("test_counter_total", "Test counter",
+                                         "cluster=\"1\""));
+  EXPECT_NE(counter, Metrics::GetCounter("test_counter_total", "Test counter",
+                                         "cluster=\"2\""));
+
+  counter->Increment();
+  counter->Increment(2);
+  auto text = Metrics::Export();
+  EXPECT_NE(text.find("# TYPE test_counter_total counter\n"), string::npos);
+  EXPECT_NE(text.find("test_counter_total{cluster=\"1\"} 3\n"), string::npos);
+  EXPECT_NE(text.find("test_counter_total{cluster=\"2\"} 0\n"), string::npos);
+}
+
+TEST(Metrics, HistogramBuckets) {
+  auto histogram =
+      Metrics::GetHistogram("test_seconds", "Test histogram", "cluster=\"1\"");
+  histogram->Observe(50);
+  histogram->Observe(2000);
+  histogram->Observe(1000000000);
+
+  int64 counts[MetricHistogram::kNumBuckets];
+  int64 sum_us;
+  histogram->Read(counts, sum_us);
+  EXPECT_EQ(counts[0], 1);
+  EXPECT_EQ(counts[4], 1);
+  EXPECT_EQ(counts[MetricHistogram::kNumBuckets - 1], 1);
+  EXPECT_EQ(sum_us, 1000002050);
+
+  auto text = Metrics::Export();
+  EXPECT_NE(text.find("test_seconds_bucket{cluster=\"1\",le=\"0.0001\"} 1\n"),
+            string::npos);
+  EXPECT_NE(text.find("test_seconds_bucket{cluster=\"1\",le=\"0.0025\"} 2\n"),
+            string::npos);
+  EXPECT_NE(text.find("test_seconds_bucket{cluster=\"1\",le=\"+Inf\"} 3\n"),
+            string::npos);
+  EXPECT_NE(text.find("test_seconds_count{cluster=\"1\"} 3\n"), string::npos);
+}
+
+}  // namespace testing
+}  // namespace ngraph_bridge
+}  // namespace tensorflow
@@ -0,0 +1,71 @@
+/*******************************************************************************
+ * Copyright 2017-2020 Intel Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *******************************************************************************/
+
+
+#include "gtest/gtest.h"
+
+#include "ngraph_bridge/tracer.h"
+
+using namespace std;
+
+namespace tensorflow {
+namespace ngraph_bridge {
+namespace testing {
+
+static int CountOccurrences(const string& text, const string& pattern) {
+  int count = 0;
+  for (auto pos = text.find(pattern); pos != string::npos;
+       pos = text.find(pattern, pos + 1)) {
+    count++;
+  }
+  return count;
+}
+
+TEST(Tracer, RecordsSpansWithContext) {
+  Tracer::Flush();
+  Tracer::Enable();
+  {
+    Tracer::ContextScope context(7, 42);
+    TraceSpan span("TestSpan");
+  }
+  Tracer::Disable();
+  {
+    TraceSpan span("DisabledSpan");
+  }
+
+  auto trace = Tracer::Flush();
+  EXPECT_EQ(CountOccurrences(trace, "\"name\":\"TestSpan\""), 1);
+  EXPECT_EQ(CountOccurrences(trace, "\"cluster_id\":7,\"step_id\":42"), 1);
+  EXPECT_EQ(CountOccurrences(trace, "DisabledSpan"), 0);
+
+  // Flushing empties the buffer
+  EXPECT_EQ(CountOccurrences(Tracer::Flush(), "\"ph\":\"X\""), 0);
+}
+
+TEST(Tracer, ContextScopesNest) {
+  Tracer::ContextScope outer(1, 10);
+  {
+    Tracer::ContextScope inner(2, 20);
+    EXPECT_EQ(Tracer::CurrentContext().cluster_id, 2);
+    EXPECT_EQ(Tracer::CurrentContext().step_id, 20);
+  }
+  EXPECT_EQ(Tracer::CurrentContext().cluster_id, 1);
+  EXPECT_EQ(Tracer::CurrentContext().step_id, 10);
+}
+
+}  // namespace testing
+}  // namespace ngraph_bridge
+}  // namespace tensorflow
@@ -0,0 +1,114 @@
+/*******************************************************************************
+ * Copyright 2017-2020 Intel Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *******************************************************************************/
+
+#include <iostream>
+
+#include "gtest/gtest.h"
+
+#include "tensorflow/core/graph/graph.h"
+#include "tensorflow/core/graph/node_builder.h"
+
+#include "ngraph_bridge/ngraph_builder.h"
+#include "ngraph_bridge/timer.h"
+#include "test/test_utilities.h"
+
+using namespace std;
+
+namespace tensorflow {
+namespace ngraph_bridge {
+namespace testing {
+
+// Builds a cluster graph of num_ops ops, alternating Relu and Add ops that
+// add the output of the op two steps back, with a single input and output
+static void BuildLargeGraph(int num_ops, Graph& graph) {
+  Node* arg;
+  ASSERT_OK(NodeBuilder("arg", "_Arg")
+                .Attr("T", DT_FLOAT)
+                .Attr("index", 0)
+                .Finalize(&graph, &arg));
+  Node* prev = arg;
+  Node* prev2 = arg;
+  for (int i = 0; i < num_ops; i++) {
+    Node* node;
+    string name = "op_" + to_string(i);
+    if (i % 2 == 0) {
+      ASSERT_OK(NodeBuilder(name, "Relu")
+                    .Input(prev, 0)
+                    .Attr("T", DT_FLOAT)
+                    .Finalize(&graph, &node));
+    } else {
+      ASSERT_OK(NodeBuilder(name, "Add")
+                    .Input(prev, 0)
+                    .Input(prev2, 0)
+                    .Attr("T", DT_FLOAT)
+                    .Finalize(&graph, &node));
+    }
+    prev2 = prev;
+    prev = node;
+  }
+  Node* retval;
+  ASSERT_OK(NodeBuilder("retval", "_Retval")
+                .Input(prev, 0)
+                .Attr("T", DT_FLOAT)
+                .Attr("index", 0)
+                .Finalize(&graph, &retval));
+}
+
+// Large clusters translate to a single function with an op per TF op
+TEST(TranslateGraph, LargeGraph) {
+  const int num_ops = 1000;
+  Graph graph(OpRegistry::Global());
+  BuildLargeGraph(num_ops, graph);
+
+  vector<TensorShape> input_shapes{TensorShape{2, 3}};
+  vector<const Tensor*> static_input_map(1, nullptr);
+  shared_ptr<ngraph::Function> ng_function;
+  ASSERT_OK(Builder::TranslateGraph(input_shapes, static_input_map, &graph,
+                                    "large_graph", ng_function));
+  ASSERT_EQ(ng_function->get_parameters().size(), 1);
+  ASSERT_EQ(ng_function->get_results().size(), 1);
+  EXPECT_EQ(ng_function->get_results()[0]->get_shape(),
+            ngraph::Shape({2, 3}));
+  EXPECT_GE(ng_function->get_ops().size(), num_ops);
+}
+
+// Reports the translation time of large clusters, to track the cost of
+// translation per node as it is optimized. Disabled as it takes a while,
+// run it with --gtest_also_run_disabled_tests.
+TEST(TranslateGraph, DISABLED_LargeGraphBenchmark) {
+  for (int num_ops : {1000, 10000, 50000}) {
+    Graph graph(OpRegistry::Global());
+    BuildLargeGraph(num_ops, graph);
+
+    vector<TensorShape> input_shapes{TensorShape{2, 3}};
+    vector<const Tensor*> static_input_map(1, nullptr);
+    shared_ptr<ngraph::Function> ng_function;
+    Timer translate_time;
+    ASSERT_OK(Builder::TranslateGraph(input_shapes, static_input_map, &graph,
+                                      "large_graph", ng_function));
+    int elapsed_us = translate_time.ElapsedInMicroSec();
+
+    ASSERT_EQ(ng_function->get_results().size(), 1);
+    EXPECT_GE(ng_function->get_ops().size(), num_ops);
+    cout << "TranslateGraph of " << num_ops << " ops: " << elapsed_us / 1000
+         << " ms, " << static_cast<double>(elapsed_us) / num_ops
+         << " us per op" << endl;
+  }
+}
+
+}  // namespace testing
+}  // namespace ngraph_bridge
+}  // namespace tensorflow
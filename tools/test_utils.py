@@ -126,6 +126,13 @@ def run_ngtf_cpp_gtests(artifacts_dir, log_dir, filters):
         cmd = ['./gtest_ngtf']
 
     command_executor(cmd)
+
+    # Tests replacing global operators run in a binary of their own
+    if os.path.exists('gtest_call_bindings'):
+        os.environ[
+            'GTEST_OUTPUT'] = 'xml:%s/xunit_gtest_call_bindings.xml' % log_dir
+        cmd[0] = './gtest_call_bindings'
+        command_executor(cmd)
     os.chdir(root_pwd)
 
 